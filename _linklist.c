@@ -57,21 +57,35 @@ void *_realloc(void *old_mem_blk, size_t old_size, size_t new_size)
  * @n: number of bytes to write
  *
  * Description: The _memcpy() function copies @n bytes from memory area @src to
- * memory area @dest. The memory areas must not overlap.
+ * memory area @dest. The memory areas must not overlap. Once @dest is
+ * aligned, whole words are copied, four at a time while there are enough.
  *
  * Return: A pointer to @dest
  */
 void *_memcpy(void *dest, const void *src, size_t n)
 {
-	size_t i;
+	char *d = (char *)dest;
+	const char *s = (const char *)src;
 
-	char *temp_dest = (char *)dest;
-	const char *temp_src = (const char *)src;
-
-	for (i = 0; i < n; i++)
+	for (; n > 0 && !word_aligned(d); n--)
+		*d++ = *s++;
+	for (; n >= 4 * WORD_SIZE; n -= 4 * WORD_SIZE)
+	{
+		*(word_t *)d = *(const uword_t *)s;
+		*(word_t *)(d + WORD_SIZE) = *(const uword_t *)(s + WORD_SIZE);
+		*(word_t *)(d + 2 * WORD_SIZE) = *(const uword_t *)(s + 2 * WORD_SIZE);
+		*(word_t *)(d + 3 * WORD_SIZE) = *(const uword_t *)(s + 3 * WORD_SIZE);
+		d += 4 * WORD_SIZE;
+		s += 4 * WORD_SIZE;
+	}
+	for (; n >= WORD_SIZE; n -= WORD_SIZE)
 	{
-		temp_dest[i] = temp_src[i];
+		*(word_t *)d = *(const uword_t *)s;
+		d += WORD_SIZE;
+		s += WORD_SIZE;
 	}
+	while (n-- > 0)
+		*d++ = *s++;
 
 	return (dest);
 }
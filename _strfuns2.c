@@ -34,22 +34,33 @@ int _strncmp(const char *s1, const char *s2, size_t n)
  * @c: the character to search
  *
  * Description: The _strchr() function returns a pointer to the first
- * occurrence of the character @c in the string @s.
+ * occurrence of the character @c in the string @s. Aligned words holding
+ * neither @c nor the null byte are skipped whole.
  *
  * Return: a pointer to the matched character or NULL if the character
  * is not found
  */
-char *_strchr(const char *s, int c)
+NO_ASAN char *_strchr(const char *s, int c)
 {
 	char *tmp_s = (char *)s;
+	size_t pattern = WORD_ONES * (unsigned char)c;
 
 	/* handle empty string */
 	if (s == NULL)
 		return (NULL);
 
+	for (; !word_aligned(tmp_s) && *tmp_s != '\0'; tmp_s++)
+	{
+		if (*tmp_s == (char)c)
+			return (tmp_s); /* match found */
+	}
+	while (word_aligned(tmp_s) && !has_zero(*(const word_t *)tmp_s) &&
+		   !has_zero(*(const word_t *)tmp_s ^ pattern))
+		tmp_s += WORD_SIZE;
+
 	while (*tmp_s != '\0')
 	{
-		if (*tmp_s == c)
+		if (*tmp_s == (char)c)
 			return (tmp_s); /* match found */
 		tmp_s++;
 	}
@@ -61,40 +72,6 @@ char *_strchr(const char *s, int c)
 	return (NULL); /* no match found or end of string - return NULL */
 }
 
-/**
- * _strstr - locate a substring
- * @haystack: string
- * @needle: substring
- *
- * Description: The strstr() function finds the first occurrence of the
- * substring @needle in the string @haystack. The terminating null bytes('\\0')
- * are not compared.
- *
- * Return: return a pointer to the beginning of the located substring,
- * or NULL if the substring is not found.
- */
-char *_strstr(const char *haystack, const char *needle)
-{
-	size_t i, j;
-
-	for (i = 0; haystack[i]; i++)
-	{
-		j = 0;
-
-		/* keep searching so long as characters in both strings are equal */
-		while (haystack[i + j] == needle[j] && needle[j])
-			j++;
-
-		/* end of substring reached - it means there was a full match */
-		if (needle[j] == '\0')
-		{
-			return ((char *)&haystack[i]);
-		}
-	}
-
-	return (NULL); /* no match found */
-}
-
 /**
  * _strdup - Duplicates a string.
  * @str: string to duplicate
@@ -108,25 +85,19 @@ char *_strstr(const char *haystack, const char *needle)
 char *_strdup(const char *str)
 {
 	char *dup_str;
-	size_t i = 0;
+	size_t size;
 
 	if (str == NULL)
 		return (NULL); /* handle invalid string */
 
-	dup_str = malloc(_strlen(str) + 1);
+	size = _strlen(str) + 1;
+	dup_str = malloc(size);
 
 	if (dup_str == NULL)
 		return (NULL);
 
 	/* duplicate string - a copy process */
-	while (str[i])
-	{
-		dup_str[i] = str[i];
-		i++;
-	}
-	dup_str[i] = '\0';
-
-	return (dup_str);
+	return (_memcpy(dup_str, str, size));
 }
 
 /**
@@ -137,25 +108,26 @@ char *_strdup(const char *str)
  *
  * Description: Copy @n bytes from the string @s to @dest. If there is no null
  * byte among the first @n bytes of @s, the string in @dest will not be
- * null-terminated.
+ * null-terminated. The length to copy is found a word at a time, then the
+ * bytes are copied with _memcpy().
  *
  * Return: a pointer to the destination string @dest
  */
-char *_strncpy(char *dest, const char *src, size_t n)
+NO_ASAN char *_strncpy(char *dest, const char *src, size_t n)
 {
-	size_t i;
-
-	for (i = 0; i < n && src[i] != '\0'; i++)
-	{
-		dest[i] = src[i];
-	}
+	size_t i = 0;
 
-	while (i < n)
-	{
-		/* ensure exactly n bytes are written */
-		dest[i] = '\0';
+	while (i < n && !word_aligned(src + i) && src[i] != '\0')
 		i++;
-	}
+	while (i + WORD_SIZE <= n && word_aligned(src + i) &&
+		   !has_zero(*(const word_t *)(src + i)))
+		i += WORD_SIZE;
+	while (i < n && src[i] != '\0')
+		i++;
+	_memcpy(dest, src, i);
+
+	/* ensure exactly n bytes are written */
+	memset(dest + i, '\0', n - i);
 
 	return (dest);
 }
@@ -0,0 +1,149 @@
+#include "shell.h"
+
+/**
+ * max_suffix - finds the maximal suffix of a needle, for an ordering
+ * @n: the needle
+ * @len: length of the needle, at least 1
+ * @period: where to store the period of the suffix
+ * @reverse: 0 to order bytes the usual way, 1 for the reverse order
+ *
+ * Return: the position before the suffix, (size_t)-1 for the whole needle
+ */
+static size_t max_suffix(const unsigned char *n, size_t len, size_t *period,
+						 int reverse)
+{
+	size_t ip = (size_t)-1, jp = 0, k = 1, p = 1;
+
+	while (jp + k < len)
+	{
+		if (n[ip + k] == n[jp + k])
+		{
+			if (k == p)
+			{
+				jp += p;
+				k = 1;
+			}
+			else
+				k++;
+		}
+		else if ((n[ip + k] > n[jp + k]) != reverse)
+		{
+			jp += k;
+			k = 1;
+			p = jp - ip;
+		}
+		else
+		{
+			ip = jp++;
+			k = p = 1;
+		}
+	}
+	*period = p;
+
+	return (ip);
+}
+
+/**
+ * two_way - finds a needle in a haystack with the two-way algorithm
+ * @h: the haystack
+ * @h_len: length of the haystack
+ * @n: the needle
+ * @len: length of the needle, at least 2 and at most @h_len
+ *
+ * Description: The needle is cut at a critical factorization. At each
+ * position its right part is compared first, a mismatch there shifts by
+ * as much as was matched, and a mismatch in the left part shifts by the
+ * period. Bytes known to match from the previous position are not compared
+ * again, so the search takes linear time and no memory.
+ *
+ * Return: the first occurrence, NULL if there is none
+ */
+static char *two_way(const unsigned char *h, size_t h_len,
+					 const unsigned char *n, size_t len)
+{
+	const unsigned char *end = h + h_len;
+	size_t ms, ms2, p, p2, k, mem = 0, mem0;
+
+	ms = max_suffix(n, len, &p, 0);
+	ms2 = max_suffix(n, len, &p2, 1);
+	if (ms2 + 1 > ms + 1)
+	{
+		ms = ms2;
+		p = p2;
+	}
+
+	for (k = 0; k < ms + 1 && n[k] == n[k + p]; k++)
+		; /* the left part repeats with the period: the needle is periodic */
+	if (k < ms + 1)
+	{
+		mem0 = 0;
+		p = ((ms > len - ms - 1) ? ms : len - ms - 1) + 1;
+	}
+	else
+		mem0 = len - p;
+
+	while ((size_t)(end - h) >= len)
+	{
+		for (k = (ms + 1 > mem) ? ms + 1 : mem; k < len && n[k] == h[k]; k++)
+			;
+		if (k < len)
+		{
+			h += k - ms;
+			mem = 0;
+			continue;
+		}
+		for (k = ms + 1; k > mem && n[k - 1] == h[k - 1]; k--)
+			;
+		if (k <= mem)
+			return ((char *)h);
+		h += p;
+		mem = mem0;
+	}
+
+	return (NULL);
+}
+
+/**
+ * _strstr - locate a substring
+ * @haystack: string
+ * @needle: substring
+ *
+ * Description: The strstr() function finds the first occurrence of the
+ * substring @needle in the string @haystack. The terminating null bytes('\\0')
+ * are not compared. The first few places holding the needle's first byte,
+ * found with _strchr(), are compared directly. Searches going on longer use
+ * the two-way algorithm, so they take time linear in the haystack's length.
+ *
+ * Return: return a pointer to the beginning of the located substring,
+ * or NULL if the substring is not found.
+ */
+char *_strstr(const char *haystack, const char *needle)
+{
+	size_t h_len, n_len, i, tries;
+
+	if (needle[0] == '\0')
+		return ((char *)haystack);
+
+	/* most searches end within a few tries, before the needle is factorized */
+	for (tries = 0; tries < STRSTR_TRIES; tries++)
+	{
+		haystack = _strchr(haystack, needle[0]);
+		if (haystack == NULL)
+			return (NULL); /* no match found */
+		for (i = 1; needle[i] != '\0' && haystack[i] == needle[i]; i++)
+			;
+		if (needle[i] == '\0')
+			return ((char *)haystack);
+		if (haystack[i] == '\0')
+			return (NULL); /* the haystack ends before the needle could */
+		haystack++;
+	}
+
+	n_len = _strlen(needle);
+	h_len = _strlen(haystack);
+	if (h_len < n_len)
+		return (NULL); /* no match found */
+
+	return (two_way((const unsigned char *)haystack, h_len,
+					(const unsigned char *)needle, n_len));
+}
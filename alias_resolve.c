@@ -0,0 +1,185 @@
+#include "shell.h"
+
+/**
+ * resolve_alias - works out the words an alias expands to
+ * @table: the alias table
+ * @alias: the alias, its value split
+ *
+ * Description: The first word of the value is replaced by the value of the
+ * alias it names, if any, whose first word is replaced in turn, and so on.
+ * Every alias of the chain is marked as it is reached, an alias naming one
+ * already in it ends the chain there instead of looping, as does one whose
+ * first word is its own name. The words are only pointed to, they live in
+ * the values of the aliases, and the result is kept until an alias is
+ * defined or removed.
+ *
+ * Return: 0 on success, -1 if memory ran out
+ */
+static int resolve_alias(alias_table_t *table, alias_t *alias)
+{
+	unsigned long mark = ++table->marks;
+	alias_t *last = alias, *next;
+	size_t n = alias->n_words, i;
+	char **words;
+
+	alias->mark = mark;
+	alias->link = NULL;
+	while (last->n_words > 0)
+	{
+		next = find_alias(table, last->words[0]);
+		if (next == NULL || next->words == NULL || next->mark == mark)
+			break;
+		next->mark = mark;
+		next->link = last;
+		n = n - 1 + next->n_words;
+		last = next;
+	}
+
+	words = malloc((n + 1) * sizeof(char *));
+	if (words == NULL)
+		return (-1);
+	/* the innermost value first, then what followed each first word */
+	for (n = 0; n < last->n_words; n++)
+		words[n] = last->words[n];
+	for (next = last->link; next != NULL; next = next->link)
+	{
+		for (i = 1; i < next->n_words; i++)
+			words[n++] = next->words[i];
+	}
+	words[n] = NULL;
+	safe_free(alias->resolved);
+	alias->resolved = words;
+	alias->n_resolved = n;
+	alias->gen = table->gen;
+
+	return (0);
+}
+
+/**
+ * find_alias - looks an alias up by name
+ * @table: the alias table
+ * @name: the name
+ *
+ * Return: the alias, NULL if there is none by that name
+ */
+alias_t *find_alias(const alias_table_t *table, const char *name)
+{
+	alias_t *alias;
+
+	if (table->count == 0 || name == NULL)
+		return (NULL);
+	/* a name that was never interned is no alias */
+	name = find_interned(name);
+	if (name == NULL)
+		return (NULL);
+	alias = alias_slot(table, name, hash_text(name, _strlen(name)));
+
+	return ((alias->name != NULL) ? alias : NULL);
+}
+
+/**
+ * expand_alias - replaces the name of an alias by what it expands to in the
+ * arguments of the current command
+ * @hsh: contains all the data relevant to the shell's operation
+ * @alias: the alias named by the first argument
+ *
+ * Description: The words are resolved when the alias is first used after
+ * the aliases changed, using it is then a single copy of them and of the
+ * arguments that follow into a new array in the arena. They stay in the
+ * alias table, the command must not outlive a change to its aliases.
+ *
+ * Return: 0 on success, -1 if memory ran out, which is reported
+ */
+int expand_alias(shell_t *hsh, alias_t *alias)
+{
+	size_t n = 0;
+	char **argv;
+
+	if (alias->words == NULL)
+		return (0); /* not a usable value, leave the command as it is */
+	if ((alias->resolved == NULL || alias->gen != hsh->aliases.gen) &&
+		resolve_alias(&hsh->aliases, alias) == -1)
+	{
+		fprintf(stderr, "alias: Memory allocation failed\n");
+		return (-1);
+	}
+
+	while (hsh->sub_command[n + 1] != NULL)
+		n++;
+	n += alias->n_resolved + 1;
+	argv = arena_alloc(&hsh->arena, n * sizeof(char *));
+	if (argv == NULL)
+	{
+		fprintf(stderr, "alias: Memory allocation failed\n");
+		return (-1);
+	}
+	_memcpy(argv, alias->resolved, alias->n_resolved * sizeof(char *));
+	_memcpy(argv + alias->n_resolved, hsh->sub_command + 1,
+			(n - alias->n_resolved) * sizeof(char *));
+	hsh->sub_command = argv;
+
+	return (0);
+}
+
+/**
+ * remove_alias - removes an alias
+ * @table: the alias table
+ * @name: the alias's name
+ *
+ * Description: The aliases that come after it in its run of slots are
+ * shifted back into the gap when they can go there, so that lookups never
+ * have to step over removed aliases.
+ *
+ * Return: 0 on success, 1 if there is no such alias
+ */
+int remove_alias(alias_table_t *table, const char *name)
+{
+	alias_t *alias = find_alias(table, name);
+	size_t mask = table->size - 1, hole, i, home;
+
+	if (alias == NULL)
+		return (1);
+	safe_free(alias->value); /* the name is interned */
+	safe_free(alias->text);
+	safe_free(alias->words);
+	safe_free(alias->resolved);
+	memset(alias, 0, sizeof(alias_t));
+	table->count--;
+	table->gen++;
+
+	hole = alias - table->slots;
+	for (i = (hole + 1) & mask; table->slots[i].name != NULL;
+		 i = (i + 1) & mask)
+	{
+		home = table->slots[i].hash & mask;
+		/* it may move back unless its home is between the gap and it */
+		if ((i > hole) ? (home <= hole || home > i) :
+			(home <= hole && home > i))
+		{
+			table->slots[hole] = table->slots[i];
+			memset(&table->slots[i], 0, sizeof(alias_t));
+			hole = i;
+		}
+	}
+
+	return (0);
+}
+
+/**
+ * free_aliases - releases the alias table
+ * @table: the table
+ */
+void free_aliases(alias_table_t *table)
+{
+	size_t i;
+
+	for (i = 0; i < table->size; i++)
+	{
+		safe_free(table->slots[i].value);
+		safe_free(table->slots[i].text);
+		safe_free(table->slots[i].words);
+		safe_free(table->slots[i].resolved);
+	}
+	safe_free(table->slots);
+	table->size = table->count = 0;
+}
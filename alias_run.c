@@ -0,0 +1,141 @@
+#include "shell.h"
+
+/**
+ * alias_line - writes the command line a compound alias runs
+ * @alias: the alias
+ * @args: the NULL-terminated arguments that followed its name
+ *
+ * Description: The arguments are expanded already, they go after the value
+ * between single quotes so that they are taken as they are.
+ *
+ * Return: the line, to be freed, NULL if memory ran out
+ */
+static char *alias_line(const alias_t *alias, char **args)
+{
+	size_t len = _strlen(alias->value), size = len + 1, i;
+	const char *p;
+	char *line, *at;
+
+	for (i = 0; args[i] != NULL; i++)
+	{
+		for (size += 3, p = args[i]; *p != '\0'; p++)
+			size += (*p == '\'') ? 4 : 1;
+	}
+	line = malloc(size);
+	if (line == NULL)
+		return (NULL);
+	_memcpy(line, alias->value, len);
+	for (at = line + len, i = 0; args[i] != NULL; i++)
+	{
+		*at++ = ' ';
+		*at++ = '\'';
+		for (p = args[i]; *p != '\0'; p++)
+		{
+			if (*p == '\'')
+			{
+				_memcpy(at, "'\\''", 4);
+				at += 4;
+			}
+			else
+				*at++ = *p;
+		}
+		*at++ = '\'';
+	}
+	*at = '\0';
+
+	return (line);
+}
+
+/**
+ * compile_alias - compiles the command line of a compound alias
+ * @hsh: contains all the data relevant to the shell's operation
+ * @line: the line
+ *
+ * Description: The line is lexed and parsed apart from the line being run,
+ * whose lexer and parser are put aside meanwhile, and compiled into a
+ * program of its own.
+ *
+ * Return: the program, with a reference to release, NULL on syntax errors,
+ * which are reported, or if memory ran out
+ */
+static program_t *compile_alias(shell_t *hsh, char *line)
+{
+	lexer_t lexer = hsh->lexer;
+	parser_t parser = hsh->parser;
+	program_t *prog = NULL;
+	node_t *tree = NULL;
+
+	memset(&hsh->lexer, 0, sizeof(lexer_t));
+	memset(&hsh->parser, 0, sizeof(parser_t));
+	if (lex_line(&hsh->lexer, line) == -1 && hsh->lexer.error == NULL)
+		fprintf(stderr, "Not enough system memory to continue\n");
+	else
+	{
+		tree = parse_program(&hsh->parser, hsh->lexer.tokens,
+						hsh->lexer.error == NULL);
+		if (hsh->lexer.error != NULL || hsh->parser.bad != NULL)
+		{
+			print_syntax_error(hsh);
+			tree = NULL;
+		}
+	}
+	prog = (tree != NULL) ? new_program(hsh) : NULL;
+	if (prog != NULL)
+		prog->refs++;
+	if (prog != NULL && compile_program(prog, tree) == -1)
+	{
+		release_program(hsh, prog);
+		prog = NULL;
+	}
+	free_lexer(&hsh->lexer);
+	free_parser(&hsh->parser);
+	hsh->lexer = lexer;
+	hsh->parser = parser;
+
+	return (prog);
+}
+
+/**
+ * run_alias - runs a compound alias with the arguments of the current
+ * command
+ * @hsh: contains all the data relevant to the shell's operation
+ * @alias: the alias named by the first argument, compound
+ *
+ * Description: The value is run as if it had been typed with the
+ * arguments after it, in the shell's process. The alias is not expanded
+ * again while it runs, so a value using its own name does not loop.
+ *
+ * Return: the exit code of the line, 2 on syntax errors, 1 if memory ran
+ * out
+ */
+int run_alias(shell_t *hsh, alias_t *alias)
+{
+	char **argv = hsh->sub_command, *line;
+	const char *name = alias->name;
+	int subshell = hsh->subshell;
+	program_t *prog;
+
+	line = alias_line(alias, argv + 1);
+	if (line == NULL)
+	{
+		fprintf(stderr, "alias: Memory allocation failed\n");
+		return (1);
+	}
+	prog = compile_alias(hsh, line);
+	safe_free(line);
+	if (prog == NULL)
+		return (CMD_ERR);
+	alias->running = 1;
+	hsh->sub_command = NULL;
+	hsh->subshell = 0; /* its commands must not replace the shell */
+	vm_run(hsh, prog, 0);
+	release_program(hsh, prog);
+	/* the line may have changed the aliases, the slot may have moved */
+	alias = find_alias(&hsh->aliases, name);
+	if (alias != NULL)
+		alias->running = 0;
+	hsh->sub_command = argv;
+	hsh->subshell = subshell;
+
+	return (hsh->exit_code);
+}
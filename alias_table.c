@@ -0,0 +1,186 @@
+#include "shell.h"
+
+/**
+ * alias_slot - finds the slot of an alias in the alias table
+ * @table: the table, it has at least one free slot
+ * @name: the name, interned
+ * @hash: the name's hash
+ *
+ * Return: the slot holding the alias, or the free slot it would go in
+ */
+alias_t *alias_slot(const alias_table_t *table, const char *name,
+					unsigned long hash)
+{
+	size_t i = hash & (table->size - 1);
+
+	/* interned names are equal only if they are the same string */
+	while (table->slots[i].name != NULL && table->slots[i].name != name)
+		i = (i + 1) & (table->size - 1);
+
+	return (&table->slots[i]);
+}
+
+/**
+ * grow_aliases - doubles the number of slots of the alias table
+ * @table: the table
+ *
+ * Description: The words of the aliases are not moved, only the slots
+ * pointing to them, so the arguments of a running command stay good.
+ *
+ * Return: 0 on success, -1 if memory ran out
+ */
+static int grow_aliases(alias_table_t *table)
+{
+	alias_t *old = table->slots;
+	size_t i, old_size = table->size;
+
+	table->size = old_size ? old_size * 2 : ALIAS_MIN;
+	table->slots = calloc(table->size, sizeof(alias_t));
+	if (table->slots == NULL)
+	{
+		table->slots = old;
+		table->size = old_size;
+		return (-1);
+	}
+
+	for (i = 0; i < old_size; i++)
+	{
+		if (old[i].name != NULL)
+			*alias_slot(table, old[i].name, old[i].hash) = old[i];
+	}
+	safe_free(old);
+
+	return (0);
+}
+
+/**
+ * split_value - splits the value of an alias into the words it runs
+ * @alias: the alias, its value set
+ *
+ * Description: The value is lexed once, when the alias is defined, and its
+ * words unquoted in a copy of it, so that using the alias does not go over
+ * the text again. A value with operators, as "cd /tmp && ls", is not a
+ * list of words: it is left unsplit and marked compound, and runs as a
+ * command line of its own when the alias is used. A value that does not
+ * lex is left unsplit too, the alias then leaves the commands using it as
+ * they are.
+ *
+ * Return: 0 on success, -1 if memory ran out
+ */
+static int split_value(alias_t *alias)
+{
+	lexer_t lexer;
+	size_t i;
+
+	lexer.tokens = NULL;
+	lexer.count = lexer.size = 0;
+	lexer.error = NULL;
+	alias->text = _strdup(alias->value);
+	if (alias->text == NULL)
+		return (-1);
+	if (lex_line(&lexer, alias->text) == -1)
+	{
+		free_lexer(&lexer);
+		return ((lexer.error != NULL) ? 0 : -1);
+	}
+	for (i = 0; i < lexer.count; i++)
+	{
+		if (lexer.tokens[i].type != TOK_WORD &&
+			lexer.tokens[i].type != TOK_EOF)
+			alias->compound = 1;
+	}
+	alias->words = alias->compound ? NULL :
+		malloc((lexer.count + 1) * sizeof(char *));
+	for (i = 0; alias->words != NULL && i < lexer.count; i++)
+	{
+		if (lexer.tokens[i].type == TOK_WORD)
+			alias->words[alias->n_words++] =
+				token_word(&lexer.tokens[i]);
+	}
+	free_lexer(&lexer);
+	if (alias->compound)
+		return (0);
+	if (alias->words == NULL)
+		return (-1);
+	alias->words[alias->n_words] = NULL;
+
+	return (0);
+}
+
+/**
+ * copy_words - gives an alias the words of its value, split beforehand
+ * @alias: the alias, its value set
+ * @words: the words, NUL-terminated one after the other
+ * @n_words: number of words
+ *
+ * Return: 0 on success, -1 if memory ran out
+ */
+static int copy_words(alias_t *alias, const char *words, size_t n_words)
+{
+	size_t i, len = 0;
+
+	for (i = 0; i < n_words; i++)
+		len += _strlen(words + len) + 1;
+	alias->text = malloc(len + 1);
+	alias->words = malloc((n_words + 1) * sizeof(char *));
+	if (alias->text == NULL || alias->words == NULL)
+		return (-1);
+	_memcpy(alias->text, words, len);
+	for (len = 0; alias->n_words < n_words; len += _strlen(words + len) + 1)
+		alias->words[alias->n_words++] = alias->text + len;
+	alias->words[n_words] = NULL;
+
+	return (0);
+}
+
+/**
+ * add_alias - defines an alias, or gives an existing one a new value
+ * @table: the alias table
+ * @name: the name of the alias
+ * @value: its value
+ * @words: the words of the value, NUL-terminated one after the other, as
+ *         a snapshot keeps them, NULL to split the value here
+ * @n_words: number of @words
+ *
+ * Return: the alias, NULL if memory ran out
+ */
+alias_t *add_alias(alias_table_t *table, const char *name, const char *value,
+				   const char *words, size_t n_words)
+{
+	alias_t *alias;
+
+	name = intern(name);
+	if (name == NULL)
+		return (NULL);
+	if ((table->count + 1) * 2 > table->size && grow_aliases(table) == -1)
+		return (NULL);
+	alias = alias_slot(table, name, hash_text(name, _strlen(name)));
+	if (alias->name == NULL)
+	{
+		alias->name = name;
+		alias->hash = hash_text(name, _strlen(name));
+		alias->running = 0;
+		table->count++;
+	}
+	else
+	{
+		safe_free(alias->value);
+		safe_free(alias->text);
+		safe_free(alias->words);
+		safe_free(alias->resolved);
+	}
+	/* the aliases resolved through this one have to be resolved again */
+	table->gen++;
+	alias->n_words = alias->n_resolved = 0;
+	alias->compound = 0;
+	alias->value = _strdup(value);
+	if (alias->value == NULL ||
+		((words != NULL) ? copy_words(alias, words, n_words) :
+		 split_value(alias)) == -1)
+	{
+		remove_alias(table, name);
+		return (NULL);
+	}
+
+	return (alias);
+}
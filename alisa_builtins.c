@@ -1,197 +1,107 @@
 #include "shell.h"
 
 /**
- * add_alias - Adds an alias to the linked list.
- * @aliases: Pointer to the list containing aliases.
- * @name: The name of the alias to be added.
- * @value: The value associated with the name.
+ * cmp_aliases - orders two aliases by name, for qsort()
+ * @a: the first alias
+ * @b: the second alias
  *
- * Return: The address of the newly added node (alias),
- *         or the address of the previous if it already exists.
+ * Return: less than, equal to or greater than 0 as @a's name sorts before,
+ * with or after @b's
  */
-
-alias_t *add_alias(alias_t **aliases, const char *name, const char *value)
+static int cmp_aliases(const void *a, const void *b)
 {
-	alias_t *current, *alias;
-
-	alias = malloc(sizeof(alias_t));
-	if (alias == NULL)
-		return (NULL);
-
-	alias->name = _strdup(name);
-	alias->value = _strdup(value);
-	alias->next = NULL;
-
-	if (*aliases == NULL)
-	{
-		(*aliases) = alias;
-		return (*aliases);
-	}
-
-	current = *aliases;
-	while (current != NULL)
-	{
-		if (!_strcmp(name, current->name))
-		{
-			safe_free(current->value);
-			current->value = _strdup(value);
-			safe_free(alias->name);
-			safe_free(alias->value);
-			safe_free(alias);
+	return (_strcmp((*(alias_t *const *)a)->name,
+					(*(alias_t *const *)b)->name));
+}
 
-			return (current);
-		}
-		current = current->next;
-	}
+/**
+ * show_alias - prints an alias as the command defining it
+ * @alias: the alias
+ *
+ * Description: The value is put between single quotes, a quote in it ends
+ * and reopens them, so the line can be run again as it is.
+ */
+static void show_alias(const alias_t *alias)
+{
+	const char *p;
 
-	current = *aliases;
-	while (current->next != NULL)
+	printf("%s='", alias->name);
+	for (p = alias->value; *p != '\0'; p++)
 	{
-		current = current->next;
+		if (*p == '\'')
+			fputs("'\\''", stdout);
+		else
+			putchar(*p);
 	}
-	current->next = alias;
-
-	return (alias);
+	fputs("'\n", stdout);
 }
 
 /**
- * print_aliases - prints all the aliases
- * @aliases: the list of aliases
+ * print_aliases - prints all the aliases, sorted by name
+ * @table: the alias table
  */
-void print_aliases(const alias_t *aliases)
+void print_aliases(const alias_table_t *table)
 {
+	alias_t **aliases = malloc((table->count + 1) * sizeof(alias_t *));
+	size_t i, n = 0;
+
 	if (aliases == NULL)
+	{
+		fprintf(stderr, "alias: Memory allocation failed\n");
 		return;
-
-	while (aliases != NULL)
+	}
+	for (i = 0; i < table->size; i++)
 	{
-		printf("%s='%s'\n", aliases->name, aliases->value);
-		aliases = aliases->next;
+		if (table->slots[i].name != NULL)
+			aliases[n++] = &table->slots[i];
 	}
+	qsort(aliases, n, sizeof(alias_t *), cmp_aliases);
+	for (i = 0; i < n; i++)
+		show_alias(aliases[i]);
+	safe_free(aliases);
 }
 
 /**
- * unalias - Removes an alias from the list.
- * @aliases: Pointer to the list of aliases.
- * @command: Null-terminated array of aliases to be removed.
+ * unalias - Removes aliases from the alias table.
+ * @table: The alias table.
+ * @names: The NULL-terminated names of the aliases to remove.
  *
- * Return: 0 if the alias was found and removed successfully, else 1.
+ * Return: 0 if the aliases were found and removed successfully, else 1.
  */
 
-int unalias(alias_t **aliases, char *command)
+int unalias(alias_table_t *table, char **names)
 {
-	alias_t *current, *prev;
-	size_t i;
-	char **names;
-	int exit_code = 1; /* assume failure by default */
-
-	names = _strtok(command, NULL);
-	if (names == NULL)
-		return (-1);
+	int exit_code = 0;
 
-	current = *aliases;
-	for (i = 1; names[i] != NULL; i++)
+	for (; *names != NULL; names++)
 	{
-		while (current != NULL)
-		{
-			if (!_strcmp(current->name, names[i]))
-			{
-				if (current == *aliases)
-					*aliases = (*aliases)->next;
-				else
-					prev->next = current->next;
-				multi_free("ss", current->name, current->value);
-				safe_free(current);
-				exit_code = 0;
-				break;
-			}
-			prev = current;
-			current = current->next;
-		}
-		current = *aliases; /* point back to aliases before next run */
-
-		if (exit_code != 0)
+		if (remove_alias(table, *names) != 0)
 		{
-			fprintf(stderr, "unalias: %s not found\n", names[i]);
+			fprintf(stderr, "unalias: %s not found\n", *names);
 			exit_code = 1;
 		}
-		safe_free(names[i]);
 	}
-	free_str(&names);
 	return (exit_code);
 }
 
 /**
  * print_alias - Prints a specific alias based on the given name.
- * @aliases: The list of aliases.
+ * @table: The alias table.
  * @name: The name of the alias to be printed.
  *
  * Return: 0 if the alias was found, else 1.
  */
 
-int print_alias(const alias_t *aliases, const char *name)
+int print_alias(const alias_table_t *table, const char *name)
 {
-	if (aliases == NULL)
-	{
-		fprintf(stderr, "alias: %s not found\n", name);
-		return (1); /* the list is empty, can't search */
-	}
+	const alias_t *alias = find_alias(table, name);
 
-	while (aliases != NULL)
-	{
-		if (!_strcmp(aliases->name, name))
-		{
-			printf("%s='%s'\n", aliases->name, aliases->value);
-			return (0);
-		}
-		aliases = aliases->next;
-	}
-
-	/* we reached the end of the list and didn't find the specified alias */
-	fprintf(stderr, "alias: %s not found\n", name);
-	return (1);
-}
-
-/**
- * get_alias - Retrieves the value of an alias from a list.
- * @aliases: The list containing aliases.
- * @name: The name of the alias.
- *
- * Return: The value of the alias, or NULL if not found.
- */
-
-char *get_alias(alias_t *aliases, const char *name)
-{
-	char *value, *chained_value;
-	alias_t *current;
-
-	if (aliases == NULL || name == NULL)
-		return (NULL); /* aliases is empty or name provided is invalid */
-
-	current = aliases;
-
-	while (current != NULL)
+	if (alias == NULL)
 	{
-		if (!_strcmp(current->name, name))
-		{
-			value = _strdup(current->value);
-			if (value == NULL)
-				return (NULL);
-			if (!_strcmp(current->name, current->value))
-				return (value);
-
-			/* check for aliases chained to other aliases */
-			chained_value = get_alias(aliases, value);
-			if (chained_value != NULL)
-			{
-				safe_free(value);
-				return (chained_value);
-			}
-
-			return (value); /* not a chained value, return as-is */
-		}
-		current = current->next;
+		fprintf(stderr, "alias: %s not found\n", name);
+		return (1);
 	}
 
-	return (NULL);
+	show_alias(alias);
+	return (0);
 }
@@ -0,0 +1,115 @@
+#include "shell.h"
+
+/**
+ * arena_alloc - hands out memory from an arena
+ * @a: the arena
+ * @size: number of bytes
+ *
+ * Description: Memory is taken from the current chunk by moving a pointer.
+ * Chunks are kept when the arena is released, so once the shell has run
+ * its largest command, commands do not allocate anymore. A chunk too small
+ * for the request is skipped, a new one is put in front of it.
+ *
+ * Return: the memory, aligned for any pointer, NULL if memory ran out
+ */
+void *arena_alloc(arena_t *a, size_t size)
+{
+	arena_chunk_t *chunk = a->current, *next;
+	size_t chunk_size;
+	void *mem;
+
+	size = (size + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1);
+	while (chunk == NULL || chunk->used + size > chunk->size)
+	{
+		next = (chunk == NULL) ? a->chunks : chunk->next;
+		if (next == NULL || next->size < size)
+		{
+			chunk_size = (size > ARENA_CHUNK) ? size : ARENA_CHUNK;
+			next = malloc(sizeof(arena_chunk_t) + chunk_size);
+			if (next == NULL)
+			{
+				fprintf(stderr, "Not enough system memory to continue\n");
+				return (NULL);
+			}
+			next->size = chunk_size;
+			next->next = (chunk == NULL) ? a->chunks : chunk->next;
+			if (chunk == NULL)
+				a->chunks = next;
+			else
+				chunk->next = next;
+		}
+		next->used = 0;
+		chunk = next;
+	}
+
+	a->current = chunk;
+	mem = (char *)(chunk + 1) + chunk->used;
+	chunk->used += size;
+
+	return (mem);
+}
+
+/**
+ * arena_strdup - copies a string to an arena
+ * @a: the arena
+ * @str: the string
+ *
+ * Return: the copy, NULL if memory ran out
+ */
+char *arena_strdup(arena_t *a, const char *str)
+{
+	size_t len = _strlen(str) + 1;
+	char *copy = arena_alloc(a, len);
+
+	if (copy != NULL)
+		_memcpy(copy, str, len);
+
+	return (copy);
+}
+
+/**
+ * arena_mark - records how much of an arena is in use
+ * @a: the arena
+ *
+ * Return: the mark, to give to arena_release()
+ */
+arena_mark_t arena_mark(const arena_t *a)
+{
+	arena_mark_t mark;
+
+	mark.chunk = a->current;
+	mark.used = (a->current != NULL) ? a->current->used : 0;
+
+	return (mark);
+}
+
+/**
+ * arena_release - gives back everything allocated since a mark
+ * @a: the arena
+ * @mark: the mark
+ *
+ * Description: Marks are released in the reverse order they were taken.
+ */
+void arena_release(arena_t *a, arena_mark_t mark)
+{
+	a->current = mark.chunk;
+	if (mark.chunk != NULL)
+		mark.chunk->used = mark.used;
+}
+
+/**
+ * free_arena - releases the chunks of an arena
+ * @a: the arena
+ */
+void free_arena(arena_t *a)
+{
+	arena_chunk_t *next;
+
+	while (a->chunks != NULL)
+	{
+		next = a->chunks->next;
+		safe_free(a->chunks);
+		a->chunks = next;
+	}
+	a->current = NULL;
+}
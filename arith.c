@@ -0,0 +1,185 @@
+#include "shell.h"
+
+/**
+ * read_var - reads the value of a parameter as a number
+ * @hsh: shell data
+ * @name: the parameter's name
+ * @value: where to store the number
+ *
+ * Return: 0 on success, -1 if the value is not a number (it is reported)
+ */
+static int read_var(shell_t *hsh, const char *name, intmax_t *value)
+{
+	const char *str;
+	char num[32];
+
+	str = get_param(hsh, name, _strlen(name), num);
+	if (arith_value(str, value) == -1)
+	{
+		fprintf(stderr, "%s: %lu: Illegal number: %s\n", hsh->prog_name,
+				hsh->cmd_count, str);
+		hsh->exit_code = 2;
+		return (-1);
+	}
+
+	return (0);
+}
+
+/**
+ * write_var - sets a variable to a number
+ * @hsh: shell data
+ * @name: the variable's name
+ * @value: the number
+ *
+ * Return: 0 on success, -1 if the variable is read-only or memory ran out
+ */
+static int write_var(shell_t *hsh, const char *name, intmax_t value)
+{
+	char num[32];
+
+	_imtoa(value, num);
+	if (assign_var(hsh, name, _strlen(name), num, 0) == -1)
+	{
+		hsh->exit_code = 2;
+		return (-1);
+	}
+
+	return (0);
+}
+
+/**
+ * binary_op - applies a binary operator
+ * @op: the operator
+ * @a: the left operand
+ * @b: the right operand
+ * @value: where to store the result
+ *
+ * Description: Sums and products wrap around, shifts only use the low bits
+ * of their count, as the hardware does.
+ *
+ * Return: 0 on success, -1 on a division by zero
+ */
+static int binary_op(int op, intmax_t a, intmax_t b, intmax_t *value)
+{
+	if ((op == '/' || op == '%') && b == 0)
+		return (-1);
+	if ((op == '/' || op == '%') && b == -1) /* INTMAX_MIN / -1 overflows */
+		*value = (op == '/') ? (intmax_t)(0 - (uintmax_t)a) : 0;
+	else if (op == '*' || op == '+' || op == '-')
+		*value = (intmax_t)((op == '*') ? (uintmax_t)a * (uintmax_t)b :
+							(op == '+') ? (uintmax_t)a + (uintmax_t)b :
+							(uintmax_t)a - (uintmax_t)b);
+	else if (op == AO_SHL || op == AO_SHR)
+	{
+		b &= sizeof(intmax_t) * 8 - 1;
+		*value = (op == AO_SHL) ? (intmax_t)((uintmax_t)a << b) : a >> b;
+	}
+	else
+		*value = (op == '/') ? a / b : (op == '%') ? a % b
+			: (op == '<') ? a < b : (op == '>') ? a > b
+			: (op == AO_LE) ? a <= b : (op == AO_GE) ? a >= b
+			: (op == AO_EQ) ? a == b : (op == AO_NE) ? a != b
+			: (op == '&') ? a & b : (op == '^') ? a ^ b : a | b;
+
+	return (0);
+}
+
+/**
+ * run_insn - runs an instruction of an expression, other than a jump
+ * @hsh: shell data
+ * @expr: the expression
+ * @in: the instruction
+ * @stack: the values
+ * @top: index of the value on top
+ *
+ * Return: 0 on success, -1 on errors (they are reported)
+ */
+static int run_insn(shell_t *hsh, const arith_expr_t *expr,
+					const arith_insn_t *in, intmax_t *stack, int *top)
+{
+	intmax_t value = 0, *v = &stack[*top];
+
+	if (in->kind == A_NUM || in->kind == A_VAR || in->kind == A_INCR)
+		v = &stack[++*top];
+	if (in->kind == A_BINARY || in->kind == A_POP)
+		v = &stack[--*top]; /* A_POP is done once the top is dropped */
+	if (in->kind == A_NUM)
+		*v = in->value;
+	else if (in->kind == A_UNARY)
+		*v = (in->op == '-') ? (intmax_t)(0 - (uintmax_t)*v)
+			: (in->op == '!') ? !*v : (in->op == '~') ? ~*v : *v;
+	else if (in->kind == A_BOOL)
+		*v = (*v != 0);
+	else if (in->kind == A_VAR || in->kind == A_INCR ||
+			 (in->kind == A_ASSIGN && in->op != '='))
+	{
+		if (read_var(hsh, in->name, &value) == -1)
+			return (-1);
+		if (in->kind == A_VAR)
+			*v = value;
+	}
+	if ((in->kind == A_BINARY && binary_op(in->op, *v, v[1], v) == -1) ||
+		(in->kind == A_ASSIGN && in->op != '=' &&
+		 binary_op(in->op, value, *v, v) == -1))
+	{
+		arith_error(hsh, "division by zero", expr->text, expr->len);
+		return (-1);
+	}
+	if (in->kind == A_INCR)
+		*v = (intmax_t)((uintmax_t)value + (uintmax_t)in->value);
+	if ((in->kind == A_ASSIGN || in->kind == A_INCR) &&
+		write_var(hsh, in->name, *v) == -1)
+		return (-1);
+	if (in->kind == A_INCR && in->op)
+		*v = value;
+
+	return (0);
+}
+
+/**
+ * arith_eval - evaluates an arithmetic expression
+ * @hsh: shell data
+ * @text: the expression, not NUL-terminated
+ * @len: length of the expression
+ * @value: where to store the value
+ *
+ * Description: The expression is parsed once, by find_arith(), then its
+ * code is run on a stack of ARITH_DEPTH values, which the parser made sure
+ * is enough. "&&", "||" and "?:" skip the operand they do not evaluate, so
+ * its assignments are not done.
+ *
+ * Return: 0 on success, -1 on errors (they are reported, the exit code is 2)
+ */
+int arith_eval(shell_t *hsh, const char *text, size_t len, intmax_t *value)
+{
+	const arith_expr_t *expr = find_arith(hsh, text, len);
+	const arith_insn_t *in;
+	intmax_t stack[ARITH_DEPTH + 1];
+	int top = -1, jump;
+	size_t pc;
+
+	if (expr == NULL)
+		return (-1);
+	for (pc = 0; pc < expr->n_code; pc++)
+	{
+		in = &expr->code[pc];
+		jump = (in->kind == A_JMP) || (in->kind == A_JZ && stack[top] == 0) ||
+			   (in->kind == A_AND && stack[top] == 0) ||
+			   (in->kind == A_OR && stack[top] != 0);
+		if (in->kind == A_JZ || in->kind == A_AND || in->kind == A_OR)
+		{
+			if (in->kind == A_OR && jump)
+				stack[top] = 1;
+			if (in->kind == A_JZ || !jump)
+				top--;
+		}
+		else if (in->kind != A_JMP &&
+				 run_insn(hsh, expr, in, stack, &top) == -1)
+			return (-1);
+		if (jump)
+			pc = in->jump - 1; /* the loop moves on to the target */
+	}
+	*value = stack[top];
+
+	return (0);
+}
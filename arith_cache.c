@@ -0,0 +1,119 @@
+#include "shell.h"
+
+/**
+ * arith_error - reports an error in an arithmetic expression
+ * @hsh: shell data
+ * @what: what went wrong
+ * @text: the expression
+ * @len: length of the expression
+ */
+void arith_error(shell_t *hsh, const char *what, const char *text,
+				 size_t len)
+{
+	fprintf(stderr, "%s: %lu: arithmetic expression: %s: \"%.*s\"\n",
+			hsh->prog_name, hsh->cmd_count, what, (int)len, text);
+	hsh->exit_code = 2;
+}
+
+/**
+ * add_arith - parses an expression and keeps it in the cache
+ * @hsh: shell data
+ * @text: the expression
+ * @len: length of the expression
+ * @hash: hash of the expression
+ *
+ * Description: The entry and a copy of the text are allocated at once. The
+ * cache is emptied when it holds too many expressions, those of the loops
+ * running now are parsed again on their next turn.
+ *
+ * Return: the parsed expression, NULL on errors (they are reported)
+ */
+static arith_expr_t *add_arith(shell_t *hsh, const char *text, size_t len,
+							   unsigned long hash)
+{
+	arith_cache_t *cache = &hsh->arith;
+	arith_parser_t ap;
+	arith_expr_t *expr;
+	size_t slot = hash & (ARITH_SLOTS - 1);
+
+	if (parse_arith(&ap, text, len) == -1)
+	{
+		arith_error(hsh, ap.error, text, len);
+		safe_free(ap.code);
+		return (NULL);
+	}
+	if (cache->count >= ARITH_CACHE_MAX)
+		free_arith(cache);
+	if (cache->slots == NULL)
+		cache->slots = calloc(ARITH_SLOTS, sizeof(arith_expr_t *));
+	expr = (cache->slots != NULL) ? malloc(sizeof(arith_expr_t) + len) : NULL;
+	if (expr == NULL)
+	{
+		fprintf(stderr, "Not enough system memory to continue\n");
+		safe_free(ap.code);
+		return (NULL);
+	}
+
+	expr->text = (char *)(expr + 1);
+	_memcpy(expr->text, text, len);
+	expr->len = len;
+	expr->hash = hash;
+	expr->code = ap.code;
+	expr->n_code = ap.n_code;
+	expr->next = cache->slots[slot];
+	cache->slots[slot] = expr;
+	cache->count++;
+
+	return (expr);
+}
+
+/**
+ * find_arith - finds the parsed form of an arithmetic expression
+ * @hsh: shell data
+ * @text: the expression, not NUL-terminated
+ * @len: length of the expression
+ *
+ * Description: Expressions are parsed the first time they are evaluated and
+ * kept by their text, so those of a loop's body are parsed once, whatever
+ * the program or line they come from.
+ *
+ * Return: the parsed expression, NULL on errors (they are reported)
+ */
+arith_expr_t *find_arith(shell_t *hsh, const char *text, size_t len)
+{
+	unsigned long hash = hash_text(text, len);
+	arith_expr_t *expr = NULL;
+
+	if (hsh->arith.slots != NULL)
+		expr = hsh->arith.slots[hash & (ARITH_SLOTS - 1)];
+	for (; expr != NULL; expr = expr->next)
+	{
+		if (expr->hash == hash && expr->len == len &&
+			(len == 0 || !_strncmp(expr->text, text, len)))
+			return (expr);
+	}
+
+	return (add_arith(hsh, text, len, hash));
+}
+
+/**
+ * free_arith - releases the parsed expressions
+ * @cache: the cache of expressions
+ */
+void free_arith(arith_cache_t *cache)
+{
+	arith_expr_t *expr, *next;
+	size_t i;
+
+	for (i = 0; cache->slots != NULL && i < ARITH_SLOTS; i++)
+	{
+		for (expr = cache->slots[i]; expr != NULL; expr = next)
+		{
+			next = expr->next;
+			safe_free(expr->code);
+			safe_free(expr);
+		}
+	}
+	safe_free(cache->slots);
+	cache->count = 0;
+}
@@ -0,0 +1,153 @@
+#include "shell.h"
+
+/**
+ * arith_blank - skips the blanks of an expression
+ * @p: where to start
+ * @end: the end of the expression
+ *
+ * Return: the first character that is not a blank, or @end
+ */
+const char *arith_blank(const char *p, const char *end)
+{
+	while (p < end && (isblank(*p) || *p == '\n'))
+		p++;
+
+	return (p);
+}
+
+/**
+ * arith_operator - reads a binary or an assignment operator
+ * @p: where the operator would start
+ * @end: the end of the expression
+ * @op: where to store the operator, the one of the operation for the
+ *      assignments ("+=" is '+') and '=' for a plain one
+ * @len: where to store the length of the operator
+ *
+ * Return: the precedence of the operator (P_*), 0 if there is none
+ */
+int arith_operator(const char *p, const char *end, int *op, int *len)
+{
+	static const char *const texts[] = {
+		"<<=", ">>=", "<<", ">>", "<=", ">=", "==", "!=", "&&", "||", "*=",
+		"/=", "%=", "+=", "-=", "&=", "^=", "|=", "*", "/", "%", "+", "-",
+		"<", ">", "&", "^", "|", "?", "=", ",", NULL};
+	static const int ops[] = {
+		AO_SHL, AO_SHR, AO_SHL, AO_SHR, AO_LE, AO_GE, AO_EQ, AO_NE, AO_AND,
+		AO_OR, '*', '/', '%', '+', '-', '&', '^', '|', '*', '/', '%', '+', '-',
+		'<', '>', '&', '^', '|', '?', '=', ','};
+	static const int precs[] = {
+		P_ASSIGN, P_ASSIGN, P_SHIFT, P_SHIFT, P_REL, P_REL, P_EQ, P_EQ, P_AND,
+		P_OR, P_ASSIGN, P_ASSIGN, P_ASSIGN, P_ASSIGN, P_ASSIGN, P_ASSIGN,
+		P_ASSIGN, P_ASSIGN, P_MUL, P_MUL, P_MUL, P_ADD, P_ADD, P_REL, P_REL,
+		P_BAND, P_XOR, P_BOR, P_COND, P_ASSIGN, P_COMMA};
+	int i;
+
+	for (i = 0; texts[i] != NULL; i++)
+	{
+		*len = _strlen(texts[i]);
+		if (end - p >= *len && !_strncmp(p, texts[i], *len))
+		{
+			*op = ops[i];
+			return (precs[i]);
+		}
+	}
+
+	return (0);
+}
+
+/**
+ * arith_number - reads a number: decimal, octal with a leading 0, or
+ * hexadecimal with a leading 0x
+ * @p: the first digit
+ * @end: the end of the expression
+ * @value: where to store the number
+ *
+ * Description: A number past INTMAX_MAX is INTMAX_MAX, as strtoimax()
+ * gives it, rather than wrapping around.
+ *
+ * Return: a pointer past the number, NULL if it is not a valid one
+ */
+const char *arith_number(const char *p, const char *end, intmax_t *value)
+{
+	uintmax_t n = 0;
+	unsigned int base = 10, digit;
+	const char *start;
+
+	if (p + 1 < end && *p == '0' && (p[1] == 'x' || p[1] == 'X'))
+	{
+		base = 16;
+		p += 2;
+	}
+	else if (*p == '0')
+		base = 8;
+	for (start = p; p < end; p++)
+	{
+		if (isdigit(*p))
+			digit = *p - '0';
+		else if (base == 16 && ((*p | 0x20) >= 'a' && (*p | 0x20) <= 'f'))
+			digit = (*p | 0x20) - 'a' + 10;
+		else
+			break;
+		if (digit >= base)
+			return (NULL);
+		n = (n > (uintmax_t)(INTMAX_MAX - digit) / base) ? INTMAX_MAX
+			: n * base + digit;
+	}
+	if (p == start || (p < end && (isalpha(*p) || *p == '_')))
+		return (NULL);
+	*value = (intmax_t)n;
+
+	return (p);
+}
+
+/**
+ * arith_value - converts the value of a variable to a number
+ * @str: the value, NULL if the variable is not set
+ * @value: where to store the number
+ *
+ * Description: Unset and empty variables are 0. Otherwise the value must
+ * be a number, with an optional sign and blanks around it.
+ *
+ * Return: 0 on success, -1 if the value is not a number
+ */
+int arith_value(const char *str, intmax_t *value)
+{
+	const char *end, *p;
+	int sign = 1;
+
+	*value = 0;
+	if (str == NULL || *str == '\0')
+		return (0);
+	end = str + _strlen(str);
+	p = arith_blank(str, end);
+	if (p < end && issign(*p))
+		sign = isnegative(*p++);
+	if (p == end || !isdigit(*p))
+		return (-1);
+	p = arith_number(p, end, value);
+	if (p == NULL || arith_blank(p, end) != end)
+		return (-1);
+	if (sign < 0)
+		*value = (intmax_t)(0 - (uintmax_t)*value);
+
+	return (0);
+}
+
+/**
+ * arith_name - measures the variable name at the start of a string
+ * @p: where the name would start
+ * @end: the end of the expression
+ *
+ * Return: the length of the name, 0 if there is none
+ */
+size_t arith_name(const char *p, const char *end)
+{
+	const char *start = p;
+
+	if (p == end || (!isalpha(*p) && *p != '_'))
+		return (0);
+	while (p < end && (isalpha(*p) || isdigit(*p) || *p == '_'))
+		p++;
+
+	return (p - start);
+}
@@ -0,0 +1,33 @@
+#include "shell.h"
+
+/**
+ * parse_nested - parses a $((...)) inside an arithmetic expression
+ * @ap: the parser
+ * @p: the '$' of the nested expression
+ *
+ * Description: The inner expression is parsed in place, as if it had been
+ * put between parentheses, down to the "))" that closes it.
+ *
+ * Return: 0 on success, -1 on errors (ap->error says what went wrong)
+ */
+int parse_nested(arith_parser_t *ap, const char *p)
+{
+	const char *end = skip_arith(p + 1), *outer = ap->end;
+
+	if (end == NULL || end > outer)
+	{
+		ap->error = "expecting '))'";
+		return (-1);
+	}
+	ap->p = p + 3;
+	ap->end = end - 2;
+	if (arith_blank(ap->p, ap->end) == ap->end)
+		ap->error = "expecting primary";
+	else if (arith_binary(ap, P_COMMA) == 0 &&
+			 arith_blank(ap->p, ap->end) != ap->end)
+		ap->error = "expecting '))'";
+	ap->end = outer;
+	ap->p = end;
+
+	return ((ap->error == NULL) ? 0 : -1);
+}
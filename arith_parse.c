@@ -0,0 +1,265 @@
+#include "shell.h"
+
+/**
+ * emit_arith - appends an instruction to the code of an expression
+ * @ap: the parser
+ * @kind: what the instruction does (A_*)
+ * @op: the operator
+ * @value: the number, or the increment
+ * @name: the parameter, interned, or NULL
+ *
+ * Description: The values on the stack are counted as the code grows, an
+ * expression needing more than ARITH_DEPTH of them is refused.
+ *
+ * Return: the index of the instruction, -1 on errors (ap->error is set)
+ */
+static int emit_arith(arith_parser_t *ap, int kind, int op, intmax_t value,
+					  const char *name)
+{
+	size_t size = ap->size ? ap->size * 2 : 16;
+	arith_insn_t *code;
+
+	if (ap->n_code == ap->size)
+	{
+		code = _realloc(ap->code, ap->size * sizeof(arith_insn_t),
+						size * sizeof(arith_insn_t));
+		if (code == NULL)
+		{
+			ap->error = "out of memory";
+			return (-1);
+		}
+		ap->code = code;
+		ap->size = size;
+	}
+	if (kind == A_NUM || kind == A_VAR || kind == A_INCR)
+		ap->stack++;
+	else if (kind != A_UNARY && kind != A_ASSIGN && kind != A_BOOL)
+		ap->stack--; /* the jumps too: the value of the other branch */
+	if (ap->stack > ARITH_DEPTH)
+	{
+		ap->error = "expression too deep";
+		return (-1);
+	}
+
+	code = &ap->code[ap->n_code];
+	code->kind = kind;
+	code->op = op;
+	code->jump = 0;
+	code->value = value;
+	code->name = name;
+
+	return (ap->n_code++);
+}
+
+/**
+ * parse_name - parses a parameter, with what may follow a variable
+ * @ap: the parser, past the name
+ * @name: the name
+ * @len: length of the name
+ * @prefix: '$' if the name followed one, it is then only read, '+' or '-'
+ *          if it followed "++" or "--", 0 otherwise
+ *
+ * Description: A variable may be followed by "++" or "--", to be changed
+ * once read, or by an assignment operator and the expression giving its
+ * value.
+ *
+ * Return: 0 on success, -1 on errors
+ */
+static int parse_name(arith_parser_t *ap, const char *name, size_t len,
+					  int prefix)
+{
+	const char *interned = NULL;
+	char *copy = malloc(len + 1);
+	int op, op_len, kind = A_VAR;
+
+	if (copy != NULL)
+	{
+		_memcpy(copy, name, len);
+		copy[len] = '\0';
+		interned = intern(copy);
+		safe_free(copy);
+	}
+	if (interned == NULL)
+	{
+		ap->error = "out of memory";
+		return (-1);
+	}
+
+	ap->p = arith_blank(ap->p, ap->end);
+	op = (prefix == 0 && ap->end - ap->p >= 2 && issign(*ap->p) &&
+		  ap->p[1] == *ap->p) ? *ap->p : prefix;
+	if (op == '+' || op == '-')
+	{
+		ap->p += (prefix == 0) ? 2 : 0;
+		return ((emit_arith(ap, A_INCR, prefix == 0, (op == '+') ? 1 : -1,
+							interned) == -1) ? -1 : 0);
+	}
+	if (prefix == 0 &&
+		arith_operator(ap->p, ap->end, &op, &op_len) == P_ASSIGN)
+	{
+		ap->p += op_len;
+		if (arith_binary(ap, P_COND) == -1)
+			return (-1);
+		kind = A_ASSIGN;
+	}
+
+	return ((emit_arith(ap, kind, op, 0, interned) == -1) ? -1 : 0);
+}
+
+/**
+ * parse_primary - parses a number, a parameter, a parenthesized or nested
+ * expression or a unary operator and its operand
+ * @ap: the parser
+ *
+ * Return: 0 on success, -1 on errors
+ */
+static int parse_primary(arith_parser_t *ap)
+{
+	const char *p = arith_blank(ap->p, ap->end), *name = NULL;
+	size_t len = 0;
+	intmax_t value;
+	int r = -1;
+
+	ap->p = p + 1;
+	if (++ap->nesting > ARITH_DEPTH)
+		ap->error = "expression too deep";
+	else if (p == ap->end)
+		ap->error = "expecting primary";
+	else if (ap->end - p >= 2 && issign(*p) && p[1] == *p)
+	{
+		name = arith_blank(p + 2, ap->end);
+		len = arith_name(name, ap->end);
+		ap->p = name + len;
+		if (len == 0)
+			ap->error = "expecting name";
+		else
+			r = parse_name(ap, name, len, *p);
+	}
+	else if (*p == '$' && p + 3 <= ap->end && p[1] == '(' && p[2] == '(')
+		r = parse_nested(ap, p);
+	else if (*p == '$')
+	{
+		ap->p = scan_param(p + 1, &name, &len);
+		if (ap->p == NULL || ap->p > ap->end || len == 0 || *name == '@' ||
+			*name == '*')
+			ap->error = "bad substitution";
+		else
+			r = parse_name(ap, name, len, '$');
+	}
+	else if (*p == '(')
+	{
+		if (arith_binary(ap, P_COMMA) == -1)
+			return (-1);
+		ap->p = arith_blank(ap->p, ap->end);
+		if (ap->p == ap->end || *ap->p++ != ')')
+			ap->error = "expecting ')'";
+		r = (ap->error == NULL) ? 0 : -1;
+	}
+	else if (_strchr("+-!~", *p) != NULL)
+	{
+		if (parse_primary(ap) == -1)
+			return (-1);
+		r = emit_arith(ap, A_UNARY, *p, 0, NULL);
+	}
+	else if (isdigit(*p))
+	{
+		ap->p = arith_number(p, ap->end, &value);
+		if (ap->p == NULL)
+			ap->error = "bad number";
+		else
+			r = emit_arith(ap, A_NUM, 0, value, NULL);
+	}
+	else if ((len = arith_name(p, ap->end)) > 0)
+	{
+		ap->p = p + len;
+		r = parse_name(ap, p, len, 0);
+	}
+	else
+		ap->error = "expecting primary";
+	ap->nesting--;
+
+	return ((r == -1) ? -1 : 0);
+}
+
+/**
+ * arith_binary - parses an expression by precedence climbing
+ * @ap: the parser
+ * @min: the loosest operator to take (P_*)
+ *
+ * Description: An operand is parsed, then each operator binding at least
+ * as tight as @min, with its right operand made of what binds tighter than
+ * the operator. "&&", "||" and "?:" jump over what they do not evaluate.
+ *
+ * Return: 0 on success, -1 on errors
+ */
+int arith_binary(arith_parser_t *ap, int min)
+{
+	int prec, op, len, kind, at = -1;
+
+	if (parse_primary(ap) == -1)
+		return (-1);
+	for (;;)
+	{
+		ap->p = arith_blank(ap->p, ap->end);
+		prec = arith_operator(ap->p, ap->end, &op, &len);
+		if (prec < min || prec == P_ASSIGN)
+			return (0);
+		ap->p += len;
+		kind = (op == ',') ? A_POP : (op == '?') ? A_JZ : (op == AO_AND) ? A_AND
+			: (op == AO_OR) ? A_OR : A_BINARY;
+		if ((kind != A_BINARY && (at = emit_arith(ap, kind, 0, 0, NULL)) == -1) ||
+			arith_binary(ap, (kind == A_JZ) ? P_COMMA : prec + 1) == -1)
+			return (-1);
+		if (kind == A_JZ)
+		{
+			ap->p = arith_blank(ap->p, ap->end);
+			if (ap->p == ap->end || *ap->p++ != ':')
+			{
+				ap->error = "expecting ':'";
+				return (-1);
+			}
+			ap->code[at].jump = ap->n_code + 1;
+			if ((at = emit_arith(ap, A_JMP, 0, 0, NULL)) == -1 ||
+				arith_binary(ap, P_COND) == -1)
+				return (-1);
+		}
+		else if ((kind == A_BINARY || kind == A_AND || kind == A_OR) &&
+				 emit_arith(ap, (kind == A_BINARY) ? A_BINARY : A_BOOL, op, 0,
+							NULL) == -1)
+			return (-1);
+		if (kind != A_BINARY)
+			ap->code[at].jump = ap->n_code;
+	}
+}
+
+/**
+ * parse_arith - parses an arithmetic expression
+ * @ap: the parser, its code is to be freed by the caller
+ * @text: the expression
+ * @len: length of the expression
+ *
+ * Description: An empty expression is 0.
+ *
+ * Return: 0 on success, -1 on errors (ap->error says what went wrong)
+ */
+int parse_arith(arith_parser_t *ap, const char *text, size_t len)
+{
+	ap->p = text;
+	ap->end = text + len;
+	ap->code = NULL;
+	ap->n_code = ap->size = 0;
+	ap->nesting = ap->stack = 0;
+	ap->error = NULL;
+
+	if (arith_blank(text, ap->end) == ap->end)
+		return ((emit_arith(ap, A_NUM, 0, 0, NULL) == -1) ? -1 : 0);
+	if (arith_binary(ap, P_COMMA) == -1)
+		return (-1);
+	if (arith_blank(ap->p, ap->end) != ap->end)
+	{
+		ap->error = "expecting EOF";
+		return (-1);
+	}
+
+	return (0);
+}
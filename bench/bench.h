@@ -0,0 +1,99 @@
+/*
+ * Description: Header file for the hsh microbenchmark harness.
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include "../shell.h"
+#include <time.h>
+
+/* Macros - harness defaults */
+
+#define BENCH_MIN_NS 200000000UL /* run each case for at least 200ms */
+#define BENCH_BATCH 256			 /* number of prepared inputs per batch */
+#define BENCH_TOLERANCE 10		 /* allowed slowdown in percent */
+#define BENCH_NAME_SIZE 64
+
+/**
+ * struct bench_case - describes a single microbenchmark
+ * @name: name of the benchmark as shown in the report, a single word: it
+ *        is the first field of the saved results
+ * @setup: builds the state shared by all operations (not timed)
+ * @prepare: builds the input of operation @i of a batch (not timed)
+ * @run: performs operation @i of a batch (timed)
+ * @cleanup: releases whatever operation @i left behind (not timed)
+ * @teardown: releases the shared state (not timed)
+ */
+typedef struct bench_case
+{
+	const char *name;
+	void (*setup)(void);
+	void (*prepare)(size_t i);
+	void (*run)(size_t i);
+	void (*cleanup)(size_t i);
+	void (*teardown)(void);
+} bench_case_t;
+
+/**
+ * struct bench_result - the measurements of a single benchmark
+ * @name: name of the benchmark
+ * @ops: number of operations executed
+ * @ns_per_op: wall time per operation in nanoseconds
+ * @allocs_per_op: heap allocations per operation
+ * @bytes_per_op: heap bytes requested per operation
+ */
+typedef struct bench_result
+{
+	char name[BENCH_NAME_SIZE];
+	unsigned long ops;
+	double ns_per_op;
+	double allocs_per_op;
+	double bytes_per_op;
+} bench_result_t;
+
+/* allocation counters, maintained by the malloc wrappers */
+
+extern int bench_counting;
+extern unsigned long bench_allocs;
+extern unsigned long bench_bytes;
+
+void bench_reset_counters(void);
+
+/* the registered cases */
+
+extern const bench_case_t bench_strtok;
+extern const bench_case_t bench_word_count;
+extern const bench_case_t bench_lexer;
+extern const bench_case_t bench_parse_chain;
+extern const bench_case_t bench_compile;
+extern const bench_case_t bench_getenv;
+extern const bench_case_t bench_variables;
+extern const bench_case_t bench_arith;
+extern const bench_case_t bench_glob;
+extern const bench_case_t bench_alias;
+extern const bench_case_t bench_path;
+extern const bench_case_t bench_getline;
+extern const bench_case_t bench_scan;
+extern const bench_case_t bench_str_scan;
+extern const bench_case_t bench_memcpy;
+extern const bench_case_t bench_strstr;
+
+/* shared fixtures */
+
+shell_t *bench_shell(void);
+char *bench_command_line(size_t words);
+void bench_fill_environ(size_t count);
+char *bench_write_script(size_t lines);
+
+/* checks run before measuring */
+
+int bench_verify_strings(void);
+
+/* reporting */
+
+int bench_save(const char *filename, bench_result_t *results, size_t n);
+int bench_compare(const char *filename, bench_result_t *results, size_t n,
+				  int tolerance);
+
+#endif /* BENCH_H */
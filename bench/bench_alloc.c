@@ -0,0 +1,93 @@
+#include "bench.h"
+
+/*
+ * The benchmark binary is linked with -Wl,--wrap=<symbol> for every
+ * allocation entry point used by the shell, so each call made from the
+ * shell's objects lands here first and can be counted before being passed
+ * on to the real allocator.
+ */
+
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t nmemb, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+char *__real_strndup(const char *s, size_t n);
+
+int bench_counting;
+unsigned long bench_allocs;
+unsigned long bench_bytes;
+
+/**
+ * bench_reset_counters - zeroes the allocation counters
+ */
+void bench_reset_counters(void)
+{
+	bench_allocs = 0;
+	bench_bytes = 0;
+}
+
+/**
+ * __wrap_malloc - counts a call to malloc
+ * @size: number of bytes requested
+ *
+ * Return: the memory returned by the real malloc
+ */
+void *__wrap_malloc(size_t size)
+{
+	if (bench_counting)
+	{
+		bench_allocs++;
+		bench_bytes += size;
+	}
+	return (__real_malloc(size));
+}
+
+/**
+ * __wrap_calloc - counts a call to calloc
+ * @nmemb: number of members
+ * @size: size of each member
+ *
+ * Return: the memory returned by the real calloc
+ */
+void *__wrap_calloc(size_t nmemb, size_t size)
+{
+	if (bench_counting)
+	{
+		bench_allocs++;
+		bench_bytes += nmemb * size;
+	}
+	return (__real_calloc(nmemb, size));
+}
+
+/**
+ * __wrap_realloc - counts a call to realloc
+ * @ptr: the block to resize
+ * @size: the new size of the block
+ *
+ * Return: the memory returned by the real realloc
+ */
+void *__wrap_realloc(void *ptr, size_t size)
+{
+	if (bench_counting)
+	{
+		bench_allocs++;
+		bench_bytes += size;
+	}
+	return (__real_realloc(ptr, size));
+}
+
+/**
+ * __wrap_strndup - counts a call to strndup
+ * @s: the string to duplicate
+ * @n: maximum number of bytes to copy
+ *
+ * Return: the string returned by the real strndup
+ */
+char *__wrap_strndup(const char *s, size_t n)
+{
+	if (bench_counting)
+	{
+		bench_allocs++;
+		bench_bytes += n + 1;
+	}
+	return (__real_strndup(s, n));
+}
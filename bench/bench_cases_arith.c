@@ -0,0 +1,46 @@
+#include "bench.h"
+
+static const char bench_expr[] =
+	"i = (i * 7 + 3) % 1000, i < 500 && i > 10 ? i << 2 : i - 1";
+
+static shell_t *hsh;
+static volatile intmax_t sink;
+
+/**
+ * setup_arith - builds the shell, with the variable the expression updates
+ */
+static void setup_arith(void)
+{
+	bench_fill_environ(60);
+	hsh = bench_shell();
+	_setenv(&hsh->env, "i", "1");
+}
+
+/**
+ * run_arith - evaluates the expression of a loop's body, found parsed in
+ * the cache after the first operation
+ * @i: index of the operation in the batch
+ */
+static void run_arith(size_t i)
+{
+	intmax_t value = 0;
+
+	arith_eval(hsh, bench_expr, sizeof(bench_expr) - 1, &value);
+	sink = value + i;
+}
+
+/**
+ * teardown_arith - releases the parsed expression and the shell
+ */
+static void teardown_arith(void)
+{
+	free_arith(&hsh->arith);
+	multi_free("p", &hsh->path_list);
+	free_commands(hsh);
+	free_env(&hsh->env);
+	free_interned();
+	safe_free(hsh);
+}
+
+const bench_case_t bench_arith = {
+	"arith_eval", setup_arith, NULL, run_arith, NULL, teardown_arith};
@@ -0,0 +1,89 @@
+#include "bench.h"
+
+#define BENCH_N_FILES 500
+
+static shell_t *hsh;
+static program_t program;
+static char dir[] = "/tmp/hsh_bench_XXXXXX";
+static char *volatile sink;
+
+/**
+ * setup_glob - fills a directory with sources and headers, and compiles a
+ * command globbing both kinds, the way compile_args() does
+ */
+static void setup_glob(void)
+{
+	static const char *const words[] = {"ls", "*.c", "*.h"};
+	char path[64], word[64];
+	size_t i;
+	int fd;
+
+	hsh = bench_shell();
+	if (mkdtemp(dir) == NULL)
+	{
+		perror("bench: mkdtemp");
+		exit(1);
+	}
+	for (i = 0; i < BENCH_N_FILES; i++)
+	{
+		sprintf(path, "%s/file%03lu.%c", dir, (unsigned long)i / 2,
+				(i & 1) ? 'h' : 'c');
+		fd = open(path, O_CREAT | O_WRONLY, 0644);
+		if (fd != -1)
+			close(fd);
+	}
+	for (i = 0; i < 3; i++)
+	{
+		sprintf(word, (i > 0) ? "%s/%s" : "%.0s%s", dir, words[i]);
+		grow_buffer(&program, (void **)&program.words, program.n_words,
+					&program.words_size, sizeof(uint32_t));
+		program.words[program.n_words++] = (uint32_t)add_string(
+			&program, word, _strlen(word)) | ((i > 0) ? WORD_RAW | WORD_GLOB : 0);
+	}
+	emit(&program, OP_EXPAND, 0, program.n_words);
+}
+
+/**
+ * run_glob - builds the arguments of the command, both patterns are
+ * matched against a single listing of the directory
+ * @i: index of the operation in the batch
+ *
+ * Description: The arena is given back first, as the shell does once each
+ * command has run, so the listing is read into the same memory every time.
+ */
+static void run_glob(size_t i)
+{
+	arena_mark_t empty = {NULL, 0};
+
+	arena_release(&hsh->arena, empty);
+	sink = expand_args(hsh, &program, &program.code[0])[1 + (i & 1)];
+}
+
+/**
+ * teardown_glob - removes the directory, releases the command and the shell
+ */
+static void teardown_glob(void)
+{
+	char path[64];
+	size_t i;
+
+	for (i = 0; i < BENCH_N_FILES; i++)
+	{
+		sprintf(path, "%s/file%03lu.%c", dir, (unsigned long)i / 2,
+				(i & 1) ? 'h' : 'c');
+		unlink(path);
+	}
+	rmdir(dir);
+	free_program(&program);
+	free_expand(&hsh->expand);
+	multi_free("p", &hsh->path_list);
+	free_arena(&hsh->arena);
+	free_commands(hsh);
+	free_env(&hsh->env);
+	free_interned();
+	safe_free(hsh);
+}
+
+const bench_case_t bench_glob = {
+	"expand_args_2_globs", setup_glob, NULL, run_glob, NULL,
+	teardown_glob};
@@ -0,0 +1,80 @@
+#include "bench.h"
+
+static shell_t *hsh;
+static char *script;
+static char *missing_cmd[] = {"hsh-bench-no-such-command", NULL};
+static volatile ssize_t sink;
+
+/**
+ * setup_path - builds a shell with a 10 entry PATH and a command that is
+ * not found in any of its directories
+ */
+static void setup_path(void)
+{
+	hsh = bench_shell();
+	hsh->sub_command = missing_cmd;
+}
+
+/**
+ * teardown_path - releases the shell built by setup_path
+ */
+static void teardown_path(void)
+{
+	free_list(&hsh->path_list);
+	free_commands(hsh);
+	free_env(&hsh->env);
+	free_interned();
+	safe_free(hsh);
+}
+
+/**
+ * run_path - searches the whole PATH for the command
+ * @i: index of the operation in the batch
+ */
+static void run_path(size_t i)
+{
+	sink = handle_with_path(hsh) + i;
+}
+
+/**
+ * setup_getline - writes a 1000 line script to read back
+ */
+static void setup_getline(void)
+{
+	script = bench_write_script(1000);
+	if (script == NULL)
+	{
+		perror("bench: mkstemp");
+		exit(1);
+	}
+}
+
+/**
+ * teardown_getline - removes the script written by setup_getline
+ */
+static void teardown_getline(void)
+{
+	unlink(script);
+	safe_free(script);
+}
+
+/**
+ * run_getline - reads the script the way handle_file_as_input() does
+ * @i: index of the operation in the batch
+ */
+static void run_getline(size_t i)
+{
+	char *line = NULL;
+	size_t n = 0;
+	int fd = open(script, O_RDONLY);
+
+	sink = _getline(&line, &n, fd) + i;
+	close(fd);
+	safe_free(line);
+}
+
+const bench_case_t bench_path = {
+	"handle_with_path", setup_path, NULL, run_path, NULL, teardown_path};
+
+const bench_case_t bench_getline = {
+	"_getline", setup_getline, NULL, run_getline, NULL, teardown_getline};
@@ -0,0 +1,184 @@
+#include "bench.h"
+
+#define BENCH_N_ALIASES 200
+
+static shell_t *hsh;
+static char **argvs[BENCH_BATCH];
+static program_t program;
+static char *volatile sink;
+
+/**
+ * setup_lookup - builds a shell with a realistic environment and a large
+ * alias table
+ */
+static void setup_lookup(void)
+{
+	char name[16], value[64];
+	size_t i;
+
+	bench_fill_environ(60);
+	hsh = bench_shell();
+
+	for (i = 0; i < BENCH_N_ALIASES; i++)
+	{
+		sprintf(name, "a%03lu", (unsigned long)i);
+		sprintf(value, "ls -l --color=auto /srv/dir%03lu", (unsigned long)i);
+		add_alias(&hsh->aliases, name, value, NULL, 0);
+	}
+	/* a chained alias, resolved through the last alias defined */
+	add_alias(&hsh->aliases, "ll", "a199", NULL, 0);
+}
+
+/**
+ * teardown_lookup - releases the shell built by setup_lookup
+ */
+static void teardown_lookup(void)
+{
+	multi_free("pa", &hsh->path_list, &hsh->aliases);
+	free_arena(&hsh->arena);
+	free_commands(hsh);
+	free_env(&hsh->env);
+	free_interned();
+	safe_free(hsh);
+}
+
+/**
+ * run_getenv - looks up one of the variables added to the environment, and
+ * one that is not set
+ * @i: index of the operation in the batch
+ */
+static void run_getenv(size_t i)
+{
+	sink = _getenv(&hsh->env, "HSH_BENCH_VAR_059");
+	sink = _getenv(&hsh->env,
+				   (i & 1) ? "HSH_BENCH_MISSING" : "HSH_BENCH_ABSENT");
+}
+
+/**
+ * prepare_argv - builds the argument array of a command, the words are not
+ * owned by the array, just like the shell's
+ * @words: the words of the command
+ *
+ * Return: the argument array
+ */
+static char **prepare_argv(char **words)
+{
+	size_t n = 0;
+	char **argv;
+
+	while (words[n] != NULL)
+		n++;
+	argv = malloc((n + 1) * sizeof(char *));
+	if (argv != NULL)
+		_memcpy(argv, words, (n + 1) * sizeof(char *));
+
+	return (argv);
+}
+
+/**
+ * setup_variables - builds the shell, and a command with several
+ * expansions, compiled the way compile_args() does
+ */
+static void setup_variables(void)
+{
+	static const char *const words[] = {
+		"echo", "$HOME", "$?", "$$", "\"$HSH_BENCH_VAR_030\"/bin", "a${HOME}b",
+		"'plain'", "words", NULL};
+	int32_t offset;
+	size_t i;
+
+	setup_lookup();
+	for (i = 0; words[i] != NULL; i++)
+	{
+		grow_buffer(&program, (void **)&program.words, program.n_words,
+					&program.words_size, sizeof(uint32_t));
+		offset = add_string(&program, words[i], _strlen(words[i]));
+		program.words[program.n_words++] = (uint32_t)offset |
+			(_strchr(words[i], '$') ? WORD_RAW | WORD_GLOB : 0);
+	}
+	emit(&program, OP_EXPAND, 0, program.n_words);
+}
+
+/**
+ * run_variables - builds the arguments of the command, expanding its words
+ * @i: index of the operation in the batch
+ */
+static void run_variables(size_t i)
+{
+	sink = expand_args(hsh, &program, &program.code[0])[i & 1];
+}
+
+/**
+ * cleanup_variables - gives the arena back once per batch, as the shell
+ * does once per command
+ * @i: index of the operation in the batch
+ */
+static void cleanup_variables(size_t i)
+{
+	arena_mark_t empty = {NULL, 0};
+
+	if (i == 0)
+		arena_release(&hsh->arena, empty);
+}
+
+/**
+ * teardown_variables - releases the command and the shell
+ */
+static void teardown_variables(void)
+{
+	free_program(&program);
+	free_expand(&hsh->expand);
+	teardown_lookup();
+}
+
+/**
+ * prepare_alias - builds a command line starting with a chained alias
+ * @i: index of the operation in the batch
+ */
+static void prepare_alias(size_t i)
+{
+	static char *words[] = {"ll", "-h", "/tmp", "/var", NULL};
+
+	argvs[i] = prepare_argv(words);
+}
+
+/**
+ * run_expand_alias - looks the alias up and splices the words it expands
+ * to into the command, the way parse_helper() does
+ * @i: index of the operation in the batch
+ */
+static void run_expand_alias(size_t i)
+{
+	alias_t *alias = find_alias(&hsh->aliases, argvs[i][0]);
+
+	hsh->sub_command = argvs[i];
+	if (alias != NULL)
+		expand_alias(hsh, alias);
+	sink = hsh->sub_command[0];
+	hsh->sub_command = NULL;
+}
+
+/**
+ * cleanup_alias - frees the command line of an operation, and gives the
+ * arena back once per batch, as the shell does once per command
+ * @i: index of the operation in the batch
+ */
+static void cleanup_alias(size_t i)
+{
+	arena_mark_t empty = {NULL, 0};
+
+	safe_free(argvs[i]);
+	if (i == 0)
+		arena_release(&hsh->arena, empty);
+}
+
+const bench_case_t bench_getenv = {
+	"_getenv", setup_lookup, NULL, run_getenv, NULL, teardown_lookup};
+
+const bench_case_t bench_variables = {
+	"expand_args", setup_variables, NULL, run_variables, cleanup_variables,
+	teardown_variables};
+
+const bench_case_t bench_alias = {
+	"find_alias+expand_alias", setup_lookup, prepare_alias,
+	run_expand_alias, cleanup_alias, teardown_lookup};
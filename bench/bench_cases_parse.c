@@ -0,0 +1,164 @@
+#include "bench.h"
+
+static char *line;
+static char **words[BENCH_BATCH];
+static lexer_t lexer;
+static parser_t parser;
+static program_t program;
+static node_t *tree;
+static volatile size_t sink;
+
+/**
+ * setup_line - builds the 32 word command line shared by the parse cases
+ */
+static void setup_line(void)
+{
+	line = bench_command_line(32);
+}
+
+/**
+ * teardown_line - releases the shared command line
+ */
+static void teardown_line(void)
+{
+	safe_free(line);
+}
+
+/**
+ * run_strtok - splits the command line into words
+ * @i: index of the operation in the batch
+ */
+static void run_strtok(size_t i)
+{
+	words[i] = _strtok(line, NULL);
+}
+
+/**
+ * cleanup_strtok - frees the words produced by run_strtok
+ * @i: index of the operation in the batch
+ */
+static void cleanup_strtok(size_t i)
+{
+	free_str(&words[i]);
+}
+
+/**
+ * run_word_count - counts the words in the command line
+ * @i: index of the operation in the batch
+ */
+static void run_word_count(size_t i)
+{
+	sink += get_word_count(line, NULL) + i;
+}
+
+/**
+ * setup_lexer - builds a commented line with an and-or list to lex
+ */
+static void setup_lexer(void)
+{
+	char *words = bench_command_line(16);
+
+	line = malloc(_strlen(words) * 2 + 32);
+	if (line != NULL)
+		_strcat(_strcat(_strcat(_strcpy(line, words), " && "), words),
+				" # build the shell");
+	safe_free(words);
+}
+
+/**
+ * run_lexer - splits the line into tokens
+ * @i: index of the operation in the batch
+ */
+static void run_lexer(size_t i)
+{
+	lex_line(&lexer, line);
+	sink += lexer.count + i;
+}
+
+/**
+ * teardown_lexer - releases the line and the lexer's tokens
+ */
+static void teardown_lexer(void)
+{
+	free_lexer(&lexer);
+	safe_free(line);
+}
+
+/**
+ * setup_chain - builds a generated 200 operator '&&'/'||' chain
+ */
+static void setup_chain(void)
+{
+	size_t i;
+
+	line = malloc(200 * 16 + 16);
+	if (line == NULL)
+		return;
+	_strcpy(line, "cd /tmp");
+	for (i = 0; i < 200; i++)
+		_strcat(line, (i % 4 == 3) ? " || cd /nowhere" : " && cd /");
+}
+
+/**
+ * run_chain - lexes and parses the chain into a syntax tree
+ * @i: index of the operation in the batch
+ */
+static void run_chain(size_t i)
+{
+	lex_line(&lexer, line);
+	sink += (parse_program(&parser, lexer.tokens, 1) != NULL) + i;
+}
+
+/**
+ * teardown_chain - releases the chain, the tokens and the syntax tree
+ */
+static void teardown_chain(void)
+{
+	free_parser(&parser);
+	teardown_lexer();
+}
+
+/**
+ * setup_compile - parses the chain once, it is then compiled over and over
+ */
+static void setup_compile(void)
+{
+	setup_chain();
+	lex_line(&lexer, line);
+	tree = parse_program(&parser, lexer.tokens, 1);
+}
+
+/**
+ * run_compile - compiles the chain's syntax tree to bytecode
+ * @i: index of the operation in the batch
+ */
+static void run_compile(size_t i)
+{
+	sink += compile_program(&program, tree) + i;
+}
+
+/**
+ * teardown_compile - releases the chain, its syntax tree and its bytecode
+ */
+static void teardown_compile(void)
+{
+	free_program(&program);
+	teardown_chain();
+}
+
+const bench_case_t bench_strtok = {
+	"_strtok", setup_line, NULL, run_strtok, cleanup_strtok, teardown_line};
+
+const bench_case_t bench_word_count = {
+	"get_word_count", setup_line, NULL, run_word_count, NULL, teardown_line};
+
+const bench_case_t bench_lexer = {
+	"lex_line", setup_lexer, NULL, run_lexer, NULL, teardown_lexer};
+
+const bench_case_t bench_parse_chain = {
+	"parse_program_and_chain", setup_chain, NULL, run_chain, NULL,
+	teardown_chain};
+
+const bench_case_t bench_compile = {
+	"compile_program_and_chain", setup_compile, NULL, run_compile, NULL,
+	teardown_compile};
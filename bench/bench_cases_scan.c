@@ -0,0 +1,50 @@
+#include "bench.h"
+
+#define BENCH_SCRIPT_LINES 1000
+
+static char *script;
+static lexer_t lexer;
+static volatile size_t sink;
+
+/**
+ * setup_script - builds a script made of long quoted messages and comments,
+ * the bytes the lexer skips over in blocks
+ */
+static void setup_script(void)
+{
+	size_t i, len = 0;
+
+	script = malloc(BENCH_SCRIPT_LINES * 160);
+	if (script == NULL)
+	{
+		perror("bench: malloc");
+		exit(1);
+	}
+	for (i = 0; i < BENCH_SCRIPT_LINES; i++)
+		len += sprintf(script + len, "printf '%%s\\n' \"building target number "
+					   "%04lu of the release\" >/dev/null # keep going, the "
+					   "output is not needed\n", (unsigned long)i);
+}
+
+/**
+ * run_scan - splits the whole script into tokens
+ * @i: index of the operation in the batch
+ */
+static void run_scan(size_t i)
+{
+	lex_line(&lexer, script);
+	sink += lexer.count + i;
+}
+
+/**
+ * teardown_script - releases the script and the lexer's tokens
+ */
+static void teardown_script(void)
+{
+	free_lexer(&lexer);
+	safe_free(script);
+}
+
+const bench_case_t bench_scan = {
+	"lex_line_1000_lines", setup_script, NULL, run_scan, NULL,
+	teardown_script};
@@ -0,0 +1,85 @@
+#include "bench.h"
+
+#define BENCH_COPY_SIZE 4096
+#define BENCH_HAYSTACK_SIZE 4096
+
+static char *src, *dst, *haystack, *needle, *other;
+static volatile size_t sink;
+
+/**
+ * setup_strings - builds the buffers shared by the string cases: a page to
+ * copy, and a haystack where a naive search backtracks at every byte
+ */
+static void setup_strings(void)
+{
+	size_t i;
+
+	src = malloc(BENCH_COPY_SIZE);
+	dst = malloc(BENCH_COPY_SIZE);
+	haystack = malloc(BENCH_HAYSTACK_SIZE + 1);
+	needle = malloc(65);
+	other = malloc(65);
+	if (!src || !dst || !haystack || !needle || !other)
+	{
+		perror("bench: malloc");
+		exit(1);
+	}
+	for (i = 0; i < BENCH_COPY_SIZE; i++)
+		src[i] = 'a' + i % 26;
+	memset(haystack, 'a', BENCH_HAYSTACK_SIZE);
+	haystack[BENCH_HAYSTACK_SIZE] = '\0';
+	memset(needle, 'a', 63);
+	_strcpy(needle + 63, "b");
+	_strcpy(other, needle);
+	other[63] = 'c';
+}
+
+/**
+ * teardown_strings - releases the buffers built by setup_strings
+ */
+static void teardown_strings(void)
+{
+	multi_free("sssss", src, dst, haystack, needle, other);
+}
+
+/**
+ * run_str_scan - measures the length of a 64 byte string and compares it
+ * with one differing in the last byte
+ * @i: index of the operation in the batch
+ */
+static void run_str_scan(size_t i)
+{
+	sink += _strlen(needle) + _strcmp(needle, other) + i;
+}
+
+/**
+ * run_memcpy - copies a page
+ * @i: index of the operation in the batch
+ */
+static void run_memcpy(size_t i)
+{
+	_memcpy(dst, src, BENCH_COPY_SIZE);
+	sink += dst[i % BENCH_COPY_SIZE];
+}
+
+/**
+ * run_strstr - searches a 4 KiB haystack for a 64 byte needle that almost
+ * matches everywhere and never does
+ * @i: index of the operation in the batch
+ */
+static void run_strstr(size_t i)
+{
+	sink += (_strstr(haystack, needle) != NULL) + i;
+}
+
+const bench_case_t bench_str_scan = {
+	"_strlen+_strcmp_64b", setup_strings, NULL, run_str_scan, NULL,
+	teardown_strings};
+
+const bench_case_t bench_memcpy = {
+	"_memcpy_4k", setup_strings, NULL, run_memcpy, NULL,
+	teardown_strings};
+
+const bench_case_t bench_strstr = {
+	"_strstr_4k_periodic", setup_strings, NULL, run_strstr, NULL,
+	teardown_strings};
@@ -0,0 +1,112 @@
+#include "bench.h"
+
+static const char *const bench_words[] = {
+	"gcc", "-Wall", "-Wextra", "-pedantic", "-std=gnu89", "-O2",
+	"-o", "build/shell", "src/main.c", "src/parser.c", "$HOME",
+	"--verbose", "'quoted words'", "-I./include", "$?", "lib/util.c"};
+
+#define BENCH_N_WORDS (sizeof(bench_words) / sizeof(bench_words[0]))
+
+/**
+ * bench_shell - builds a shell context the way main() does
+ *
+ * Return: the shell context, with a realistic 10 entry PATH list
+ */
+shell_t *bench_shell(void)
+{
+	shell_t *hsh;
+
+	setenv("PATH", "/usr/local/sbin:/usr/local/bin:/usr/sbin:/usr/bin:"
+				   "/sbin:/bin:/usr/games:/usr/local/games:/snap/bin:/opt/bin",
+		   1);
+	hsh = init_shell();
+	hsh->prog_name = "hsh";
+	build_path(&hsh->env, &hsh->path_list);
+
+	return (hsh);
+}
+
+/**
+ * bench_command_line - builds a typical command line
+ * @words: number of words in the command line
+ *
+ * Return: a newly allocated command line, words are separated by a mix of
+ * spaces and tabs
+ */
+char *bench_command_line(size_t words)
+{
+	size_t i, len = 0;
+	char *line;
+
+	for (i = 0; i < words; i++)
+		len += _strlen(bench_words[i % BENCH_N_WORDS]) + 2;
+
+	line = malloc(len + 1);
+	if (line == NULL)
+		return (NULL);
+
+	*line = '\0';
+	for (i = 0; i < words; i++)
+	{
+		_strcat(line, bench_words[i % BENCH_N_WORDS]);
+		if (i + 1 < words)
+			_strcat(line, (i % 7 == 6) ? " \t" : " ");
+	}
+
+	return (line);
+}
+
+/**
+ * bench_fill_environ - grows the environment to a realistic size
+ * @count: number of extra variables to add
+ *
+ * Description: Login shells commonly carry 40 to 80 variables. They are
+ * added to the process's environment, bench_shell() must be called after
+ * for the shell to get them.
+ */
+void bench_fill_environ(size_t count)
+{
+	char name[48], value[64];
+	size_t i;
+
+	for (i = 0; i < count; i++)
+	{
+		sprintf(name, "HSH_BENCH_VAR_%03lu", (unsigned long)i);
+		sprintf(value, "/opt/hsh/bench/value/number/%03lu", (unsigned long)i);
+		setenv(name, value, 1);
+	}
+	setenv("HOME", "/home/hsh", 1);
+}
+
+/**
+ * bench_write_script - writes a script file to read back with _getline
+ * @lines: number of lines in the script
+ *
+ * Return: the newly allocated name of the script file, NULL on failure
+ */
+char *bench_write_script(size_t lines)
+{
+	char template[] = "/tmp/hsh_bench_XXXXXX", line[128];
+	size_t i;
+	int fd, len;
+
+	fd = mkstemp(template);
+	if (fd == -1)
+		return (NULL);
+
+	for (i = 0; i < lines; i++)
+	{
+		len = sprintf(line, "echo line %lu $HOME && ls -l /tmp/dir_%lu ; "
+							"cd /tmp # step %lu\n",
+					  (unsigned long)i, (unsigned long)i, (unsigned long)i);
+		if (write(fd, line, len) != len)
+		{
+			close(fd);
+			unlink(template);
+			return (NULL);
+		}
+	}
+	close(fd);
+
+	return (_strdup(template));
+}
@@ -0,0 +1,132 @@
+#include "bench.h"
+
+static const bench_case_t *const cases[] = {
+	&bench_strtok, &bench_word_count, &bench_lexer, &bench_parse_chain,
+	&bench_compile, &bench_getenv, &bench_variables, &bench_arith, &bench_glob,
+	&bench_alias, &bench_path, &bench_getline, &bench_scan, &bench_str_scan,
+	&bench_memcpy, &bench_strstr, NULL};
+
+/**
+ * now_ns - reads the monotonic clock
+ *
+ * Return: the current time in nanoseconds
+ */
+static unsigned long now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((unsigned long)ts.tv_sec * 1000000000UL + ts.tv_nsec);
+}
+
+/**
+ * measure - runs a benchmark in batches until it has run long enough
+ * @bc: the benchmark to run
+ * @res: where to store the measurements
+ *
+ * Description: Only the run() calls are timed and have their allocations
+ * counted; inputs are prepared and released between batches.
+ */
+static void measure(const bench_case_t *bc, bench_result_t *res)
+{
+	unsigned long elapsed = 0, allocs = 0, bytes = 0, ops = 0, start;
+	size_t i;
+
+	if (bc->setup)
+		bc->setup();
+	while (elapsed < BENCH_MIN_NS)
+	{
+		for (i = 0; bc->prepare && i < BENCH_BATCH; i++)
+			bc->prepare(i);
+		bench_reset_counters();
+		bench_counting = 1;
+		start = now_ns();
+		for (i = 0; i < BENCH_BATCH; i++)
+			bc->run(i);
+		elapsed += now_ns() - start;
+		bench_counting = 0;
+		allocs += bench_allocs;
+		bytes += bench_bytes;
+		ops += BENCH_BATCH;
+		for (i = 0; bc->cleanup && i < BENCH_BATCH; i++)
+			bc->cleanup(i);
+	}
+	if (bc->teardown)
+		bc->teardown();
+
+	sprintf(res->name, "%.*s", BENCH_NAME_SIZE - 1, bc->name);
+	res->ops = ops;
+	res->ns_per_op = (double)elapsed / ops;
+	res->allocs_per_op = (double)allocs / ops;
+	res->bytes_per_op = (double)bytes / ops;
+}
+
+/**
+ * usage - prints the harness usage
+ * @prog: name of the program
+ *
+ * Return: always 2
+ */
+static int usage(const char *prog)
+{
+	fprintf(stderr, "usage: %s [-f filter] [-o save_file] [-c baseline_file]"
+					" [-t tolerance_percent]\n",
+			prog);
+	return (2);
+}
+
+/**
+ * main - runs the hsh microbenchmarks and reports ns/op and allocations/op,
+ * once the string kernels are checked against libc
+ * @argc: command line arguments counter
+ * @argv: command line arguments
+ *
+ * Return: 0 on success, 1 if a kernel disagrees with libc or a regression
+ * against the baseline was found
+ */
+int main(int argc, char *argv[])
+{
+	bench_result_t results[sizeof(cases) / sizeof(cases[0])];
+	const char *filter = NULL, *save = NULL, *baseline = NULL;
+	int opt, tolerance = BENCH_TOLERANCE;
+	size_t i, n = 0;
+
+	while ((opt = getopt(argc, argv, "f:o:c:t:")) != -1)
+	{
+		if (opt == 'f')
+			filter = optarg;
+		else if (opt == 'o')
+			save = optarg;
+		else if (opt == 'c')
+			baseline = optarg;
+		else if (opt == 't')
+			tolerance = _atoi(optarg);
+		else
+			return (usage(argv[0]));
+	}
+
+	/* a fast kernel giving wrong results must not be measured */
+	if (bench_verify_strings() != 0)
+		return (1);
+
+	printf("%-28s %12s %12s %12s %12s\n", "benchmark", "ops", "ns/op",
+		   "allocs/op", "bytes/op");
+	for (i = 0; cases[i] != NULL; i++)
+	{
+		if (filter != NULL && _strstr(cases[i]->name, filter) == NULL)
+			continue;
+		measure(cases[i], &results[n]);
+		printf("%-28s %12lu %12.1f %12.2f %12.1f\n", results[n].name,
+			   results[n].ops, results[n].ns_per_op, results[n].allocs_per_op,
+			   results[n].bytes_per_op);
+		fflush(stdout);
+		n++;
+	}
+
+	if (save != NULL && bench_save(save, results, n) != 0)
+		return (1);
+	if (baseline != NULL)
+		return (bench_compare(baseline, results, n, tolerance) != 0);
+
+	return (0);
+}
@@ -0,0 +1,110 @@
+#include "bench.h"
+
+/**
+ * bench_save - saves the results so later runs can be compared against them
+ * @filename: the file to write
+ * @results: the measurements
+ * @n: number of measurements
+ *
+ * Return: 0 on success, -1 on failure
+ */
+int bench_save(const char *filename, bench_result_t *results, size_t n)
+{
+	FILE *fp = fopen(filename, "w");
+	size_t i;
+
+	if (fp == NULL)
+	{
+		perror(filename);
+		return (-1);
+	}
+
+	fprintf(fp, "# benchmark ns/op allocs/op bytes/op\n");
+	for (i = 0; i < n; i++)
+		fprintf(fp, "%s %.1f %.2f %.1f\n", results[i].name, results[i].ns_per_op,
+				results[i].allocs_per_op, results[i].bytes_per_op);
+	fclose(fp);
+
+	return (0);
+}
+
+/**
+ * find_result - looks up a measurement by name
+ * @results: the measurements
+ * @n: number of measurements
+ * @name: the benchmark name
+ *
+ * Return: the measurement, or NULL if the benchmark did not run
+ */
+static bench_result_t *find_result(bench_result_t *results, size_t n,
+								   const char *name)
+{
+	size_t i;
+
+	for (i = 0; i < n; i++)
+	{
+		if (!_strcmp(results[i].name, name))
+			return (&results[i]);
+	}
+
+	return (NULL);
+}
+
+/**
+ * bench_compare - compares the results against a saved baseline
+ * @filename: the baseline written by bench_save()
+ * @results: the measurements
+ * @n: number of measurements
+ * @tolerance: the allowed slowdown, in percent
+ *
+ * Description: Timings are noisy, so they only count as a regression once
+ * they exceed the tolerance. Allocation counts are deterministic, any
+ * increase is a regression.
+ *
+ * Return: the number of regressions found, or -1 if the baseline can't be
+ * read or has a line it cannot parse
+ */
+int bench_compare(const char *filename, bench_result_t *results, size_t n,
+				  int tolerance)
+{
+	char line[256], name[BENCH_NAME_SIZE], extra;
+	double ns, allocs, bytes;
+	bench_result_t *res;
+	int regressions = 0, slower, fatter;
+	FILE *fp = fopen(filename, "r");
+
+	if (fp == NULL)
+	{
+		perror(filename);
+		return (-1);
+	}
+
+	printf("\n%-28s %12s %12s %9s %s\n", "benchmark", "base ns/op", "ns/op",
+		   "delta", "status");
+	while (fgets(line, sizeof(line), fp) != NULL)
+	{
+		if (*line == '#' || sscanf(line, " %c", &extra) != 1)
+			continue;
+		/* a line that does not parse would hide a regression */
+		if (sscanf(line, "%63s %lf %lf %lf %c", name, &ns, &allocs,
+				   &bytes, &extra) != 4)
+		{
+			fprintf(stderr, "%s: can't parse: %s", filename, line);
+			fclose(fp);
+			return (-1);
+		}
+		res = find_result(results, n, name);
+		if (res == NULL)
+			continue;
+		slower = res->ns_per_op > ns * (100 + tolerance) / 100;
+		fatter = res->allocs_per_op > allocs + 0.005;
+		regressions += (slower || fatter);
+		printf("%-28s %12.1f %12.1f %+8.1f%% %s\n", name, ns, res->ns_per_op,
+			   (ns > 0) ? (res->ns_per_op - ns) * 100 / ns : 0.0,
+			   fatter ? "REGRESSION (allocs)"
+					  : (slower ? "REGRESSION (time)" : "ok"));
+	}
+	fclose(fp);
+
+	return (regressions);
+}
@@ -0,0 +1,104 @@
+#include "bench.h"
+
+#define VERIFY_ROUNDS 200000
+#define VERIFY_MAX_LEN 80
+
+static unsigned int seed = 1;
+
+/**
+ * random_string - fills a buffer with a random string over a small alphabet,
+ * so that substrings and equal prefixes are frequent
+ * @buf: the buffer, at least @max + 1 bytes long
+ * @max: the longest string to write
+ *
+ * Return: @buf
+ */
+static char *random_string(char *buf, size_t max)
+{
+	static const char alphabet[] = "aab\x80\xff/=";
+	size_t i, len = rand_r(&seed) % (max + 1);
+
+	for (i = 0; i < len; i++)
+		buf[i] = alphabet[rand_r(&seed) % (sizeof(alphabet) - 1)];
+	buf[len] = '\0';
+
+	return (buf);
+}
+
+/**
+ * sign - reduces a comparison result to its sign
+ * @n: the result
+ *
+ * Return: -1, 0 or 1
+ */
+static int sign(int n)
+{
+	return ((n > 0) - (n < 0));
+}
+
+/**
+ * verify_round - checks the string kernels against libc on random strings
+ * at random offsets from a word boundary
+ *
+ * Return: the name of the first kernel that disagreed, NULL if none did
+ */
+static const char *verify_round(void)
+{
+	static char a_buf[VERIFY_MAX_LEN + 16], b_buf[VERIFY_MAX_LEN + 16],
+		out[2][2 * VERIFY_MAX_LEN + 32];
+	char *a = random_string(a_buf + rand_r(&seed) % 8, VERIFY_MAX_LEN);
+	char *b = random_string(b_buf + rand_r(&seed) % 8, (rand_r(&seed) & 1) ?
+													  VERIFY_MAX_LEN : 4);
+	size_t n = rand_r(&seed) % (VERIFY_MAX_LEN + 8), off = rand_r(&seed) % 8;
+
+	if (_strlen(a) != strlen(a))
+		return ("_strlen");
+	if (sign(_strcmp(a, b)) != sign(strcmp(a, b)))
+		return ("_strcmp");
+	if (_strchr(a, *b) != strchr(a, *b))
+		return ("_strchr");
+	if (_strstr(a, b) != strstr(a, b))
+		return ("_strstr");
+	if (_strcmp(_strcpy(out[0] + off, a), strcpy(out[1] + off, a)))
+		return ("_strcpy");
+	if (_strcmp(_strcat(out[0] + off, b), strcat(out[1] + off, b)))
+		return ("_strcat");
+	memset(out[0], 'x', sizeof(out[0]));
+	memset(out[1], 'x', sizeof(out[1]));
+	_strncpy(out[0] + off, a, n);
+	strncpy(out[1] + off, a, n);
+	if (memcmp(out[0], out[1], sizeof(out[0])))
+		return ("_strncpy");
+	_memcpy(out[0] + off, b_buf + n % 8, n);
+	memcpy(out[1] + off, b_buf + n % 8, n);
+	if (memcmp(out[0], out[1], sizeof(out[0])))
+		return ("_memcpy");
+
+	return (NULL);
+}
+
+/**
+ * bench_verify_strings - checks that the string kernels give the same
+ * results as their libc counterparts before they are measured
+ *
+ * Return: 0 if they all agree, 1 otherwise
+ */
+int bench_verify_strings(void)
+{
+	const char *failed;
+	size_t i;
+
+	for (i = 0; i < VERIFY_ROUNDS; i++)
+	{
+		failed = verify_round();
+		if (failed != NULL)
+		{
+			fprintf(stderr, "bench: %s differs from libc (seed round %lu)\n",
+					failed, (unsigned long)i);
+			return (1);
+		}
+	}
+	printf("string kernels match libc on %d random inputs\n", VERIFY_ROUNDS);
+
+	return (0);
+}
@@ -0,0 +1,230 @@
+/*
+ * Description: End-to-end benchmark runner. Runs every corpus script with
+ * hsh and the system shells, and prints wall time, peak RSS and the number
+ * of system calls made by the shell process for each of them.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/ptrace.h>
+#include <sys/resource.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+#define E2E_MAX_SHELLS 8
+#define E2E_RUNS 5
+
+/**
+ * struct e2e_result - measurements of one shell on one workload
+ * @wall_ms: median wall time over all runs, in milliseconds
+ * @maxrss_kb: peak resident set size, in kilobytes
+ * @syscalls: system calls made by the shell process itself
+ * @status: exit status of the last run
+ */
+typedef struct e2e_result
+{
+	double wall_ms;
+	long maxrss_kb;
+	long syscalls;
+	int status;
+} e2e_result_t;
+
+/**
+ * spawn - starts a shell on a script with all standard streams discarded
+ * @shell: the shell to run
+ * @script: the script to run
+ * @traced: if true, the child asks to be traced before exec
+ *
+ * Return: the pid of the child, or -1 on failure
+ */
+static pid_t spawn(const char *shell, const char *script, int traced)
+{
+	char *argv[5];
+	int fd, argc = 0;
+	pid_t pid = fork();
+
+	if (pid != 0)
+		return (pid);
+
+	fd = open("/dev/null", O_RDWR);
+	dup2(fd, STDIN_FILENO);
+	dup2(fd, STDOUT_FILENO);
+	dup2(fd, STDERR_FILENO);
+	argv[argc++] = (char *)shell;
+	if (strstr(shell, "bash") != NULL)
+	{
+		/* bash only expands aliases in scripts when asked to */
+		argv[argc++] = "-O";
+		argv[argc++] = "expand_aliases";
+	}
+	argv[argc++] = (char *)script;
+	argv[argc] = NULL;
+	if (traced)
+		ptrace(PTRACE_TRACEME, 0, NULL, NULL);
+	execv(shell, argv);
+	_exit(127);
+}
+
+/**
+ * count_syscalls - runs a shell under ptrace and counts its system calls
+ * @shell: the shell to run
+ * @script: the script to run
+ *
+ * Description: Only the shell process is traced, the commands it forks are
+ * not, so the count reflects the work done by the shell itself.
+ *
+ * Return: the number of system calls, or -1 on failure
+ */
+static long count_syscalls(const char *shell, const char *script)
+{
+	long count = 0;
+	int status, sig = 0, entering = 1;
+	pid_t pid = spawn(shell, script, 1);
+
+	if (pid == -1 || waitpid(pid, &status, 0) == -1 || !WIFSTOPPED(status))
+		return (-1);
+	ptrace(PTRACE_SETOPTIONS, pid, NULL,
+		   (void *)(PTRACE_O_TRACESYSGOOD | PTRACE_O_EXITKILL));
+	while (ptrace(PTRACE_SYSCALL, pid, NULL, (void *)(long)sig) == 0)
+	{
+		if (waitpid(pid, &status, 0) == -1 || WIFEXITED(status) ||
+			WIFSIGNALED(status))
+			break;
+		sig = 0;
+		if (WSTOPSIG(status) == (SIGTRAP | 0x80))
+		{
+			count += entering;
+			entering = !entering;
+		}
+		else if (WSTOPSIG(status) != SIGTRAP)
+			sig = WSTOPSIG(status); /* pass real signals on */
+	}
+
+	return (count);
+}
+
+/**
+ * compare_double - qsort comparator for doubles
+ * @a: first value
+ * @b: second value
+ *
+ * Return: negative, zero or positive like strcmp
+ */
+static int compare_double(const void *a, const void *b)
+{
+	double x = *(const double *)a, y = *(const double *)b;
+
+	return ((x > y) - (x < y));
+}
+
+/**
+ * measure - runs a shell on a workload and collects its measurements
+ * @shell: the shell to run
+ * @script: the workload
+ * @runs: number of timed runs
+ * @res: where to store the measurements
+ */
+static void measure(const char *shell, const char *script, int runs,
+					e2e_result_t *res)
+{
+	double walls[64];
+	struct timespec start, end;
+	struct rusage usage;
+	int i, status = 0;
+	pid_t pid;
+
+	res->maxrss_kb = 0;
+	for (i = 0; i < runs; i++)
+	{
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		pid = spawn(shell, script, 0);
+		if (pid == -1 || wait4(pid, &status, 0, &usage) == -1)
+		{
+			perror("e2e: spawn");
+			exit(1);
+		}
+		clock_gettime(CLOCK_MONOTONIC, &end);
+		walls[i] = (end.tv_sec - start.tv_sec) * 1e3 +
+				   (end.tv_nsec - start.tv_nsec) / 1e6;
+		if (usage.ru_maxrss > res->maxrss_kb)
+			res->maxrss_kb = usage.ru_maxrss;
+	}
+	qsort(walls, runs, sizeof(double), compare_double);
+	res->wall_ms = walls[runs / 2];
+	res->status = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+	res->syscalls = count_syscalls(shell, script);
+}
+
+/**
+ * base_name - strips the directories from a path
+ * @path: the path
+ *
+ * Return: the last component of @path
+ */
+static const char *base_name(const char *path)
+{
+	const char *slash = strrchr(path, '/');
+
+	return ((slash != NULL) ? slash + 1 : path);
+}
+
+/**
+ * main - compares hsh against the system shells on the benchmark corpus
+ * @argc: command line arguments counter
+ * @argv: command line arguments
+ *
+ * Description: usage: e2e_run [-r runs] [-s shell]... script...
+ * Without -s, ./hsh is compared with /bin/dash and /bin/bash. The first
+ * shell is the reference the others are compared against.
+ *
+ * Return: 0 on success, 2 on usage errors
+ */
+int main(int argc, char *argv[])
+{
+	const char *shells[E2E_MAX_SHELLS] = {"./hsh", "/bin/dash", "/bin/bash"};
+	e2e_result_t res, ref;
+	int opt, i, s, runs = E2E_RUNS, n_shells = 0;
+
+	while ((opt = getopt(argc, argv, "r:s:")) != -1)
+	{
+		if (opt == 'r' && atoi(optarg) > 0 && atoi(optarg) <= 64)
+			runs = atoi(optarg);
+		else if (opt == 's' && n_shells < E2E_MAX_SHELLS)
+			shells[n_shells++] = optarg;
+		else
+		{
+			fprintf(stderr, "usage: %s [-r runs] [-s shell]... script...\n",
+					argv[0]);
+			return (2);
+		}
+	}
+	n_shells = (n_shells == 0) ? 3 : n_shells;
+	ref.wall_ms = 0;
+
+	printf("%-20s %-12s %10s %8s %11s %11s %6s\n", "workload", "shell",
+		   "wall ms", "x ref", "maxrss KB", "syscalls", "exit");
+	for (i = optind; i < argc; i++)
+	{
+		for (s = 0; s < n_shells; s++)
+		{
+			if (access(shells[s], X_OK) != 0)
+				continue;
+			measure(shells[s], argv[i], runs, &res);
+			if (s == 0)
+				ref = res;
+			printf("%-20.20s %-12.12s %10.2f %8.2f %11ld %11ld %6d\n",
+				   base_name(argv[i]), base_name(shells[s]), res.wall_ms,
+				   (ref.wall_ms > 0) ? res.wall_ms / ref.wall_ms : 0.0,
+				   res.maxrss_kb, res.syscalls, res.status);
+			fflush(stdout);
+		}
+	}
+
+	return (0);
+}
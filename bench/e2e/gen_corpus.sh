@@ -0,0 +1,96 @@
+#!/bin/sh
+#
+# Generates the end-to-end benchmark corpus.
+#
+# Every workload only uses what hsh, dash and bash have in common so the
+# same file can be handed to each shell. The unrolled loops measure the
+# cost of reading and parsing long scripts, nested_loop.sh the cost of
+# running the same parsed body over and over, function_loop.sh the cost of
+# calling a function from it and case_dispatch.sh that of a large case.
+#
+# usage: gen_corpus.sh <output directory>
+
+out=${1:-bench/e2e/corpus}
+mkdir -p "$out" || exit 1
+
+# 10k-line script: mostly builtins and comments, one fork in ten lines
+awk 'BEGIN {
+	for (i = 0; i < 10000; i++) {
+		if (i % 10 == 0)
+			printf "echo line %d of the long script\n", i;
+		else if (i % 10 == 1)
+			printf "# comment %d describing the next step\n", i;
+		else if (i % 2)
+			printf "cd /tmp\n";
+		else
+			printf "cd /\n";
+	}
+}' > "$out/lines_10k.sh"
+
+# builtin-heavy loop, unrolled: 20000 iterations of two builtins
+awk 'BEGIN {
+	for (i = 0; i < 20000; i++)
+		printf "cd /tmp; cd /\n";
+}' > "$out/builtin_loop.sh"
+
+# builtin-heavy loop, parsed once: 100 x 200 iterations of two builtins
+awk 'BEGIN {
+	printf "for i in";
+	for (i = 0; i < 100; i++)
+		printf " %d", i;
+	printf "\ndo\n\tfor j in";
+	for (i = 0; i < 200; i++)
+		printf " %d", i;
+	printf "\n\tdo\n\t\tcd /tmp; cd /\n\tdone\ndone\n";
+}' > "$out/nested_loop.sh"
+
+# function-heavy loop: the nested loop calling a two-builtin function
+awk 'BEGIN {
+	printf "hop() {\n\tcd /tmp; cd /\n}\nfor i in";
+	for (i = 0; i < 100; i++)
+		printf " %d", i;
+	printf "\ndo\n\tfor j in";
+	for (i = 0; i < 200; i++)
+		printf " %d", i;
+	printf "\n\tdo\n\t\thop\n\tdone\ndone\n";
+}' > "$out/function_loop.sh"
+
+# case-heavy routing: a 300-arm case run 100 x 200 times
+awk 'BEGIN {
+	printf "route() {\n\tcase $1 in\n";
+	for (i = 0; i < 300; i++)
+		printf "\tk%d|key%d) cd /tmp; cd / ;;\n", i, i;
+	printf "\t*) cd / ;;\n\tesac\n}\nfor i in";
+	for (i = 0; i < 100; i++)
+		printf " %d", i;
+	printf "\ndo\n\tfor j in";
+	for (i = 0; i < 200; i++)
+		printf " k%d", (i * 37) % 300;
+	printf "\n\tdo\n\t\troute $j\n\tdone\ndone\n";
+}' > "$out/case_dispatch.sh"
+
+# fork-heavy loop, unrolled: 2000 external commands
+awk 'BEGIN {
+	for (i = 0; i < 2000; i++)
+		printf "/bin/true %d\n", i;
+}' > "$out/fork_loop.sh"
+
+# alias-heavy session: 500 definitions, then 5000 uses
+awk 'BEGIN {
+	for (i = 0; i < 500; i++)
+		printf "alias a%d='\''cd /tmp'\''\n", i;
+	for (i = 0; i < 5000; i++)
+		printf "a%d\n", (i * 7) % 500;
+}' > "$out/alias_session.sh"
+
+# long && / || chains: 100 lines of 200 operators each
+awk 'BEGIN {
+	for (i = 0; i < 100; i++) {
+		line = "cd /tmp";
+		for (j = 0; j < 200; j++)
+			line = line ((j % 4 == 3) ? " || cd /nonexistent" : " && cd /");
+		print line;
+	}
+}' > "$out/andor_chain.sh"
+
+echo "corpus written to $out"
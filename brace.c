@@ -0,0 +1,201 @@
+#include "shell.h"
+
+/**
+ * brace_skip - skips what braces and commas are not special in
+ * @p: where the word is being scanned
+ * @end: end of the word
+ *
+ * Description: Quoted parts, escaped bytes, "${name}" and "$((expression))"
+ * are left for the expansions that follow.
+ *
+ * Return: a pointer to the last byte skipped, @p if nothing is
+ */
+const char *brace_skip(const char *p, const char *end)
+{
+	const char *q = p + 1;
+
+	if (*p == '\\')
+		return ((q < end) ? q : p);
+	if (*p == '$' && q + 1 < end && *q == '(' && q[1] == '(')
+	{
+		q = skip_arith(q);
+		return ((q != NULL && q <= end) ? q - 1 : p);
+	}
+	if (*p == '$' && q < end && *q == '{')
+	{
+		while (q < end && *q != '}')
+			q++;
+		return ((q < end) ? q : p);
+	}
+	if (*p != '\'' && *p != '"')
+		return (p);
+	for (; q < end && *q != *p; q++)
+	{
+		if (*p == '"' && *q == '\\' && q + 1 < end)
+			q++;
+	}
+
+	return ((q < end) ? q : p);
+}
+
+/**
+ * range_bound - reads a bound or the step of a sequence
+ * @p: where it starts, moved past it
+ * @end: end of the sequence
+ * @value: where to store it
+ * @width: where to store its width if it has leading zeros, else 0
+ *
+ * Return: 1 for a number, 2 for a letter, 0 if it is neither
+ */
+static int range_bound(const char **p, const char *end, intmax_t *value,
+					   size_t *width)
+{
+	const char *s = *p, *digits = s + (*s == '-');
+	uintmax_t n = 0;
+
+	*width = 0;
+	if (isalpha(*s) && (s + 1 == end || s[1] == '.'))
+	{
+		*value = (unsigned char)*s;
+		*p = s + 1;
+		return (2);
+	}
+	for (s = digits; s < end && isdigit(*s); s++)
+	{
+		if (n > ((uintmax_t)INTMAX_MAX - (*s - '0')) / 10)
+			return (0);
+		n = n * 10 + (*s - '0');
+	}
+	if (s == digits || (s < end && *s != '.'))
+		return (0);
+	if (*digits == '0' && s - digits > 1)
+		*width = s - *p;
+	*value = (digits > *p) ? -(intmax_t)n : (intmax_t)n;
+	*p = s;
+
+	return (1);
+}
+
+/**
+ * brace_range - reads the sequence between the braces of a group
+ * @p: what is between the braces
+ * @end: the closing brace
+ * @range: where to store the values
+ *
+ * Description: The bounds are both numbers or both letters, the step a
+ * number whose sign does not matter, the values go up or down from the
+ * first bound to the second. Numbers are padded with zeros to the width
+ * of the widest bound when one of them has leading zeros.
+ *
+ * Return: 1 if the group is a sequence, 0 otherwise
+ */
+static int brace_range(const char *p, const char *end, brace_range_t *range)
+{
+	intmax_t last, step = 1;
+	size_t width;
+	uintmax_t diff;
+	int kind;
+
+	kind = range_bound(&p, end, &range->first, &range->width);
+	if (kind == 0 || end - p < 3 || p[0] != '.' || p[1] != '.')
+		return (0);
+	p += 2;
+	if (range_bound(&p, end, &last, &width) != kind)
+		return (0);
+	range->width = (range->width > width) ? range->width : width;
+	if (p < end && (end - p < 3 || p[0] != '.' || p[1] != '.'))
+		return (0);
+	if (p < end)
+	{
+		p += 2;
+		if (range_bound(&p, end, &step, &width) != 1 || p != end)
+			return (0);
+	}
+	range->letters = (kind == 2);
+	diff = (last >= range->first) ? (uintmax_t)last - (uintmax_t)range->first
+								  : (uintmax_t)range->first - (uintmax_t)last;
+	step = (step < 0) ? -step : (step == 0) ? 1 : step;
+	range->count = diff / (uintmax_t)step + 1;
+	range->step = (last >= range->first) ? step : -step;
+
+	return (1);
+}
+
+/**
+ * brace_group - finds the first brace group of a word to expand
+ * @text: the word, as written
+ * @len: length of the word
+ * @from: where to start looking
+ * @open: where to store the index of the group's '{'
+ * @close: where to store the index of its '}'
+ * @range: where to store the values, if the group is a sequence
+ *
+ * Description: A group is a '{' and its matching '}' with a comma between
+ * them, nested groups apart, or a sequence. Other braces are kept as they
+ * are, so "{}" or "{a}" stay words.
+ *
+ * Return: 1 for a list, 2 for a sequence, 0 if the word has no group
+ */
+int brace_group(const char *text, size_t len, size_t from, size_t *open,
+				size_t *close, brace_range_t *range)
+{
+	const char *end = text + len, *p, *q;
+	int depth, comma;
+
+	for (p = text + from; p < end; p = brace_skip(p, end) + 1)
+	{
+		if (*p != '{')
+			continue;
+		depth = 1;
+		comma = 0;
+		for (q = p + 1; q < end; q = brace_skip(q, end) + 1)
+		{
+			depth += (*q == '{') - (*q == '}');
+			comma |= (*q == ',' && depth == 1);
+			if (depth == 0)
+				break;
+		}
+		if (q == end)
+			continue;
+		*open = p - text;
+		*close = q - text;
+		if (comma)
+			return (1);
+		if (brace_range(p + 1, q, range))
+			return (2);
+	}
+
+	return (0);
+}
+
+/**
+ * brace_value - writes a value of a sequence
+ * @range: the sequence
+ * @k: index of the value
+ * @buf: where to write it, room for BRACE_NUM_SIZE bytes and the padding
+ *
+ * Return: the length of the value
+ */
+size_t brace_value(const brace_range_t *range, uintmax_t k, char *buf)
+{
+	intmax_t value = (intmax_t)((uintmax_t)range->first +
+								k * (uintmax_t)range->step);
+	char num[BRACE_NUM_SIZE], *digits = num + (value < 0);
+	size_t len = 0, n;
+
+	if (range->letters)
+	{
+		buf[0] = (char)value;
+		buf[1] = '\0';
+		return (1);
+	}
+	_imtoa(value, num);
+	n = _strlen(digits);
+	if (value < 0)
+		buf[len++] = '-';
+	while (len + n < range->width)
+		buf[len++] = '0';
+	_memcpy(buf + len, digits, n + 1);
+
+	return (len + n);
+}
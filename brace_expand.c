@@ -0,0 +1,107 @@
+#include "shell.h"
+
+/**
+ * brace_add - adds a word to those a brace expansion made
+ * @out: the words
+ * @text: the word
+ * @len: length of the word
+ *
+ * Description: Empty words are dropped, as "{,x}" only gives "x".
+ *
+ * Return: 0 on success, -1 if memory ran out
+ */
+static int brace_add(brace_out_t *out, const char *text, size_t len)
+{
+	size_t size = out->size ? out->size : BUFF_SIZE;
+	char *buf;
+
+	if (len == 0)
+		return (0);
+	while (out->len + len + 1 > size)
+		size *= 2;
+	if (size > out->size)
+	{
+		buf = _realloc(out->buf, out->len, size);
+		if (buf == NULL)
+			return (-1);
+		out->buf = buf;
+		out->size = size;
+	}
+	_memcpy(out->buf + out->len, text, len);
+	out->buf[out->len + len] = '\0';
+	out->len += len + 1;
+	out->count++;
+
+	return (0);
+}
+
+/**
+ * next_comma - finds the end of an alternative of a list
+ * @text: the word
+ * @start: index of the start of the alternative
+ * @close: index of the list's '}'
+ *
+ * Return: the index of the ',' or the '}' ending it
+ */
+static size_t next_comma(const char *text, size_t start, size_t close)
+{
+	const char *end = text + close, *p;
+	int depth = 0;
+
+	for (p = text + start; p < end && (depth > 0 || *p != ',');
+		 p = brace_skip(p, end) + 1)
+		depth += (*p == '{') - (*p == '}');
+
+	return (p - text);
+}
+
+/**
+ * brace_expand - expands the brace groups of a word
+ * @out: where to add the words
+ * @text: the word, as written
+ * @len: length of the word
+ * @from: where its first group may start, nothing before expands
+ *
+ * Description: The first group is replaced by each of its alternatives, or
+ * each of its values, in turn, and the words this makes are expanded from
+ * there in their turn: "{a,b}{1,2}" gives "a1 a2 b1 b2", and the groups
+ * nested in an alternative are expanded once it is in place. The quotes
+ * are kept, the words are unquoted afterwards as any other.
+ *
+ * Return: 0 on success, -1 if memory ran out
+ */
+int brace_expand(brace_out_t *out, const char *text, size_t len, size_t from)
+{
+	size_t open, close, start, end, n, tail;
+	brace_range_t range;
+	uintmax_t k;
+	char *buf;
+	int kind, r = 0;
+
+	kind = brace_group(text, len, from, &open, &close, &range);
+	if (kind == 0)
+		return (brace_add(out, text, len));
+	tail = len - close - 1;
+	buf = malloc(len + ((kind == 2) ? range.width : 0) + BRACE_NUM_SIZE);
+	if (buf == NULL)
+		return (-1);
+	_memcpy(buf, text, open);
+	for (k = 0, start = open + 1;
+		 r == 0 && ((kind == 2) ? k < range.count : start <= close); k++)
+	{
+		if (kind == 2)
+			n = brace_value(&range, k, buf + open);
+		else
+		{
+			end = next_comma(text, start, close);
+			n = end - start;
+			_memcpy(buf + open, text + start, n);
+			start = end + 1;
+		}
+		_memcpy(buf + open + n, text + close + 1, tail);
+		r = brace_expand(out, buf, open + n + tail, open);
+	}
+	safe_free(buf);
+
+	return (r);
+}
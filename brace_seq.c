@@ -0,0 +1,78 @@
+#include "shell.h"
+
+/**
+ * brace_sequence - tells whether a word is a single sequence in plain text,
+ * as "{1..10}" or "run{01..99}.log"
+ * @word: the word, without quotes, escapes or parameters
+ * @len: length of the word
+ * @open: where to store the index of the sequence's '{'
+ * @close: where to store the index of its '}'
+ * @range: where to store the values
+ *
+ * Description: A for loop over such a word makes its words one at a time,
+ * see run_loop_op().
+ *
+ * Return: 1 if it is one, 0 otherwise
+ */
+int brace_sequence(const char *word, size_t len, size_t *open, size_t *close,
+				   brace_range_t *range)
+{
+	size_t i;
+
+	if (brace_group(word, len, 0, open, close, range) != 2)
+		return (0);
+	for (i = *close + 1; i < len; i++)
+	{
+		if (word[i] == '{')
+			return (0);
+	}
+
+	return (1);
+}
+
+/**
+ * new_brace_iter - starts making the words of a for loop over a sequence
+ * @arena: the arena the state of the loop lives in
+ * @word: the word, in the program
+ *
+ * Return: the words, NULL if memory ran out
+ */
+brace_iter_t *new_brace_iter(arena_t *arena, const char *word)
+{
+	size_t len = _strlen(word);
+	brace_iter_t *it = arena_alloc(arena, sizeof(brace_iter_t));
+
+	if (it == NULL)
+		return (NULL);
+	if (!brace_sequence(word, len, &it->open, &it->close, &it->range))
+		it->range.count = it->range.width = it->open = 0; /* no words */
+	it->buf = arena_alloc(arena, len + it->range.width + BRACE_NUM_SIZE);
+	if (it->buf == NULL)
+		return (NULL);
+	_memcpy(it->buf, word, it->open);
+	it->word = word;
+	it->index = 0;
+
+	return (it);
+}
+
+/**
+ * brace_next - makes the next word of a for loop over a sequence
+ * @it: the words
+ *
+ * Description: The part before the sequence stays in the buffer, only the
+ * value and the part after it are written each time.
+ *
+ * Return: the word, valid until the next one is made, NULL past the last
+ */
+const char *brace_next(brace_iter_t *it)
+{
+	size_t n;
+
+	if (it->index == it->range.count)
+		return (NULL);
+	n = brace_value(&it->range, it->index++, it->buf + it->open);
+	_strcpy(it->buf + it->open + n, it->word + it->close + 1);
+
+	return (it->buf);
+}
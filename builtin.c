@@ -1,101 +1,5 @@
 #include "shell.h"
 
-/**
- * _setenv - set a custom environment variable
- * @name: the name of the variable
- * @value: the value to set
- * @overwrite: if true, overwrite the variable if it exists
- *
- * Description: This function sets a custom environment variable with the given
- * name and value. If the variable already exists and overwrite is true, it
- * will be replaced.
- *
- * Return: 0 on success, 1 on error
- */
-int _setenv(const char *name, const char *value, int overwrite)
-{
-	size_t len, i;
-	char *env_var = NULL;
-
-	if (name == NULL || name[0] == '\0' || _strchr(name, '=') != NULL)
-	{
-		fprintf(stderr, "Invalid variable name: %s\n", name);
-		return (1);
-	}
-	/* check if the variable already exists */
-	if (_getenv(name) != NULL)
-	{
-		if (overwrite)
-		{
-			if (_unsetenv(name) != 0)
-				return (1);
-		}
-		else
-			return (0); /* variable exists, and overwrite is false */
-	}
-	len = _strlen(name) + _strlen(value) + 2;
-	env_var = malloc(len);
-	if (env_var == NULL)
-		return (1);
-
-	sprintf(env_var, "%s=%s", name, value);
-	for (i = 0; environ[i] != NULL; i++)
-	{
-		if (_strncmp(environ[i], name, len) == 0 && environ[i][len] == '=')
-		{
-			environ[i] = env_var;
-			safe_free(env_var);
-			return (0);
-		}
-	}
-	/* the variable doesn't exist, create it */
-	environ[i++] = env_var;
-	environ[i] = NULL;
-	safe_free(env_var);
-
-	return (0);
-}
-
-/**
- * _unsetenv - unset a custom environment variable
- * @name: The name of the variable to unset
- *
- * Description: This function unsets a custom environment variable with the
- * given name.
- *
- * Return: 0 on success, 1 on error
- */
-int _unsetenv(const char *name)
-{
-	size_t i, j, len;
-
-	/* check for invalid variable names */
-	if (name == NULL || name[0] == '\0' || _strchr(name, '=') != NULL)
-	{
-		fprintf(stderr, "Invalid variable name: %s\n", name);
-		return (1);
-	}
-
-	len = _strlen(name);
-
-	/* iterate through the environment variables and find the one to remove */
-	for (i = 0; environ[i] != NULL; i++)
-	{
-		if (_strncmp(environ[i], name, len) == 0 && environ[i][len] == '=')
-		{
-			/* shift all environment variables after the one to be removed */
-			for (j = i; environ[j] != NULL; j++)
-			{
-				environ[j] = environ[j + 1];
-			}
-			return (0);
-		}
-	}
-
-	dprintf(STDERR_FILENO, "Variable not found: %s\n", name);
-	return (1);
-}
-
 /**
  * handle_exit - handles the built-in `exit` command for the shell
  * @hsh: contains all the data relevant to the shell's operation
@@ -108,24 +12,32 @@ int handle_exit(shell_t *hsh, void (*cleanup)(const char *format, ...))
 	const char *status_code = (hsh->sub_command) ? hsh->sub_command[1] : NULL;
 	int exit_code = hsh->exit_code;
 
-	if (status_code == NULL)
+	if (status_code != NULL)
 	{
-		cleanup("spattt", hsh->line, &hsh->path_list, &hsh->aliases,
-				&hsh->commands, &hsh->sub_command, &hsh->tokens);
-		safe_free(hsh);
-		exit(exit_code);
-	}
-
-	if (isalpha(*status_code) || _atoi(status_code) < 0 || *status_code == '-')
-	{
-		dprintf(STDERR_FILENO, "%s: %lu: exit: Illegal number: %s\n",
-				hsh->prog_name, hsh->cmd_count, status_code);
-		return (CMD_ERR);
+		if (isalpha(*status_code) || _atoi(status_code) < 0 ||
+			*status_code == '-')
+		{
+			dprintf(STDERR_FILENO, "%s: %lu: exit: Illegal number: %s\n",
+					hsh->prog_name, hsh->cmd_count, status_code);
+			return (CMD_ERR);
+		}
+		exit_code = _atoi(status_code);
 	}
 
-	exit_code = _atoi(status_code);
-	cleanup("spattt", hsh->line, &hsh->path_list, &hsh->aliases,
-			&hsh->commands, &hsh->sub_command, &hsh->tokens);
+	/* the arguments and everything else the command uses are in the arena */
+	free_arena(&hsh->arena);
+	safe_free(hsh->loops.frames);
+	free_lexer(&hsh->lexer);
+	free_expand(&hsh->expand);
+	free_arith(&hsh->arith);
+	free_parser(&hsh->parser);
+	free_commands(hsh);
+	free_script_cache(&hsh->cache);
+	free_snapshot(&hsh->snapshot);
+	free_prompt(&hsh->prompt);
+	free_env(&hsh->env);
+	cleanup("spa", hsh->line, &hsh->path_list, &hsh->aliases);
+	free_interned();
 	safe_free(hsh);
 	exit(exit_code);
 }
@@ -140,7 +52,8 @@ int handle_cd(shell_t *hsh)
 {
 	char path[PATH_SIZE], pwd[BUFF_SIZE];
 	const char *pathname = hsh->sub_command[1];
-	char *home = _getenv("HOME"), *oldpath = _getenv("OLDPWD");
+	char *home = _getenv(&hsh->env, "HOME");
+	char *oldpath = _getenv(&hsh->env, "OLDPWD");
 
 	getcwd(pwd, BUFF_SIZE);
 	oldpath = (oldpath) ? oldpath : pwd;
@@ -164,9 +77,9 @@ int handle_cd(shell_t *hsh)
 		}
 		if (dash)
 			printf("%s\n", oldpath);
-		setenv("OLDPWD", pwd, 1);
+		_setenv(&hsh->env, "OLDPWD", pwd);
 		getcwd(path, PATH_SIZE);
-		setenv("PWD", path, 1);
+		_setenv(&hsh->env, "PWD", path);
 	}
 	else
 	{
@@ -174,16 +87,17 @@ int handle_cd(shell_t *hsh)
 			return (0); /* HOME is not set */
 		if (chdir(home) == -1)
 			return (CMD_ERR);
-		setenv("OLDPWD", pwd, 1);
-		setenv("PWD", home, 1);
+		_setenv(&hsh->env, "OLDPWD", pwd);
+		_setenv(&hsh->env, "PWD", home);
 	}
 	return (0);
 }
 
 /**
  * _printenv - prints all environment variables
+ * @envp: the environment, as execve() takes it
  */
-void _printenv(void)
+void _printenv(char **envp)
 {
 	int fd, status;
 	char *filename = "/tmp/env";
@@ -199,7 +113,7 @@ void _printenv(void)
 
 		child = fork();
 		if (child == 0)
-			execve(argv[0], argv, environ);
+			execve(argv[0], argv, envp);
 		else
 			waitpid(child, &status, 0);
 		close(fd);
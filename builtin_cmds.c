@@ -0,0 +1,91 @@
+#include "shell.h"
+
+/**
+ * builtin_env - handles the builtin `env` and `printenv` commands
+ * @hsh: contains all the data relevant to the shell's operation
+ *
+ * Return: always 0
+ */
+int builtin_env(shell_t *hsh)
+{
+	_printenv(env_envp(&hsh->env, &hsh->arena));
+	return (0);
+}
+
+/**
+ * builtin_exit - handles the builtin `exit` command
+ * @hsh: contains all the data relevant to the shell's operation
+ *
+ * Return: only returns if the exit status is invalid, with an error code
+ */
+int builtin_exit(shell_t *hsh)
+{
+	return (handle_exit(hsh, multi_free));
+}
+
+/**
+ * builtin_setenv - handles the builtin `setenv` command
+ * @hsh: contains all the data relevant to the shell's operation
+ *
+ * Return: 0 on success, else 1
+ */
+int builtin_setenv(shell_t *hsh)
+{
+	const char *name = hsh->sub_command[1];
+
+	if (name == NULL || hsh->sub_command[2] == NULL)
+		return (1); /* invalid number of parameters received */
+	if (_setenv(&hsh->env, name, hsh->sub_command[2]) == -1)
+	{
+		fprintf(stderr, "%s: %lu: setenv: cannot set %s\n", hsh->prog_name,
+				hsh->cmd_count, name);
+		return (1);
+	}
+
+	return (0);
+}
+
+/**
+ * builtin_unsetenv - handles the builtin `unsetenv` command
+ * @hsh: contains all the data relevant to the shell's operation
+ *
+ * Return: 0 on success, else 1
+ */
+int builtin_unsetenv(shell_t *hsh)
+{
+	const char *name = hsh->sub_command[1];
+
+	if (name == NULL || *name == '\0' || _strchr(name, '=') != NULL)
+	{
+		fprintf(stderr, "Invalid variable name: %s\n", name ? name : "");
+		return (1);
+	}
+	if (_unsetenv(&hsh->env, name) != 0)
+	{
+		fprintf(stderr, "Variable not found: %s\n", name);
+		return (1);
+	}
+
+	return (0);
+}
+
+/**
+ * builtin_break - handles the builtin `break` and `continue` commands when
+ * they are not inside a loop, they have nothing to do then
+ * @hsh: contains all the data relevant to the shell's operation
+ *
+ * Return: 0, or an error code if the loop count is invalid
+ */
+int builtin_break(shell_t *hsh)
+{
+	const char *count = hsh->sub_command[1];
+
+	if (count != NULL && (!isdigit(*count) || _atoi(count) <= 0))
+	{
+		fprintf(stderr, "%s: %lu: %s: Illegal number: %s\n", hsh->prog_name,
+				hsh->cmd_count, hsh->sub_command[0], count);
+		return (CMD_ERR);
+	}
+
+	return (0);
+}
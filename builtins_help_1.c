@@ -1,36 +1,75 @@
 #include "shell.h"
 
+/*
+ * The builtins, compiled programs refer to them by index: the script cache
+ * version must be bumped when this table changes.
+ */
+static const builtin_t builtins[N_BUILTINS + 1] = {
+	{"env", builtin_env},
+	{"printenv", builtin_env},
+	{"exit", builtin_exit},
+	{"cd", handle_cd},
+	{"setenv", builtin_setenv},
+	{"unsetenv", builtin_unsetenv},
+	{"break", builtin_break},
+	{"continue", builtin_break},
+	{"return", builtin_return},
+	{"local", builtin_local},
+	{"export", builtin_export},
+	{"readonly", builtin_readonly},
+	{"unset", builtin_unset},
+	{"snapshot", builtin_snapshot},
+	{NULL, NULL}};
+
 /**
- * handle_builtin - handles the builtin commands
- * @hsh: contains all the data relevant to the shell's operation
+ * find_builtin - looks a builtin up by name
+ * @name: the command name
  *
- * Return: exit code
+ * Return: the builtin's id, -1 if there is no such builtin
  */
-int handle_builtin(shell_t *hsh)
+int find_builtin(const char *name)
 {
-	if (!_strcmp(hsh->sub_command[0], "env") ||
-		!_strcmp(hsh->sub_command[0], "printenv"))
-	{
-		_printenv();
-		return (0);
-	}
-	else if (!_strcmp(hsh->sub_command[0], "exit"))
+	int i;
+
+	for (i = 0; builtins[i].name != NULL; i++)
 	{
-		return (handle_exit(hsh, multi_free));
+		if (!_strcmp(name, builtins[i].name))
+			return (i);
 	}
 
-	/* let's handle the builtin 'cd' command */
-	else if (!_strcmp(hsh->sub_command[0], "cd"))
-		return (handle_cd(hsh));
+	return (-1);
+}
+
+/**
+ * run_builtin - runs a builtin with the arguments of the current command
+ * @hsh: contains all the data relevant to the shell's operation
+ * @id: the builtin's id, as returned by find_builtin
+ *
+ * Return: exit code
+ */
+int run_builtin(shell_t *hsh, int id)
+{
+	return (builtins[id].run(hsh));
+}
+
+/**
+ * init_commands - fills the command table with the builtins
+ * @table: the command table, empty
+ *
+ * Return: 0 on success, -1 if memory ran out
+ */
+int init_commands(cmd_table_t *table)
+{
+	command_t *cmd;
+	int i;
 
-	else if (!_strcmp(hsh->sub_command[0], "setenv"))
+	for (i = 0; builtins[i].name != NULL; i++)
 	{
-		if (hsh->sub_command[1] && hsh->sub_command[2])
-			return (setenv(hsh->sub_command[1], hsh->sub_command[2], 1));
-		return (1); /* invalid number of parameters received */
+		cmd = add_command(table, builtins[i].name);
+		if (cmd == NULL)
+			return (-1);
+		cmd->builtin = i;
 	}
-	else if (!_strcmp(hsh->sub_command[0], "unsetenv"))
-		return (_unsetenv(hsh->sub_command[1]));
 
-	return (NOT_BUILTIN); /* not a builtin command */
+	return (0);
 }
@@ -5,22 +5,40 @@
  * @s1: string 1
  * @s2: string 2
  *
+ * Description: When both strings are at the same offset from a word
+ * boundary, they are compared a word at a time up to the first difference
+ * or the end of @s1. Bytes compare as unsigned char, as with strcmp(3).
+ *
  * Return: 0 if @s1 and @s2 are equal, a negative value if @s1 is
  * less than @s2, a positive value if @s1 is greater than @s2
  */
-int _strcmp(const char *s1, const char *s2)
+NO_ASAN int _strcmp(const char *s1, const char *s2)
 {
-	while (*s1 == *s2)
+	const unsigned char *a = (const unsigned char *)s1;
+	const unsigned char *b = (const unsigned char *)s2;
+
+	if (((uintptr_t)a & (WORD_SIZE - 1)) == ((uintptr_t)b & (WORD_SIZE - 1)))
 	{
-		if (*s1 == '\0')
+		for (; !word_aligned(a); a++, b++)
+		{
+			if (*a != *b || *a == '\0')
+				return (*a - *b);
+		}
+		while (*(const word_t *)a == *(const word_t *)b &&
+			   !has_zero(*(const word_t *)a))
 		{
-			return (0); /* Both strings are equal */
+			a += WORD_SIZE;
+			b += WORD_SIZE;
 		}
-		s1++;
-		s2++;
 	}
 
-	return (*s1 - *s2);
+	while (*a == *b && *a != '\0')
+	{
+		a++;
+		b++;
+	}
+
+	return (*a - *b);
 }
 
 /**
@@ -36,15 +54,7 @@ int _strcmp(const char *s1, const char *s2)
  */
 char *_strcat(char *dest, const char *src)
 {
-	int len, i;
-
-	len = _strlen(dest);
-
-	for (i = 0; src[i] != '\0'; i++)
-	{
-		dest[len++] = src[i];
-	}
-	dest[len] = '\0';
+	_strcpy(dest + _strlen(dest), src);
 
 	return (dest);
 }
@@ -56,20 +66,30 @@ char *_strcat(char *dest, const char *src)
  *
  * Description: copies the string pointed to by @src, including the terminating
  * null byte ('\\0'), to the buffer pointed to by @dest. The destination string
- * @dest must be large enough to receive the copy.
+ * @dest must be large enough to receive the copy. Once @src is aligned, the
+ * words without a null byte are copied whole.
  *
  * Return: a pointer to the @dest string
  */
-char *_strcpy(char *dest, const char *src)
+NO_ASAN char *_strcpy(char *dest, const char *src)
 {
-	size_t i = 0;
+	char *d = dest;
 
-	while (src[i] != '\0')
+	for (; !word_aligned(src); src++, d++)
 	{
-		dest[i] = src[i];
-		i++;
+		*d = *src;
+		if (*d == '\0')
+			return (dest);
 	}
-	dest[i] = '\0';
+	while (!has_zero(*(const word_t *)src))
+	{
+		*(uword_t *)d = *(const word_t *)src;
+		d += WORD_SIZE;
+		src += WORD_SIZE;
+	}
+	while (*src != '\0')
+		*d++ = *src++;
+	*d = '\0';
 
 	return (dest);
 }
@@ -78,54 +98,29 @@ char *_strcpy(char *dest, const char *src)
  * _strlen - returns the length of a string
  * @s: string
  *
+ * Description: Bytes are looked at one by one up to a word boundary, then a
+ * word at a time up to the word holding the null byte.
+ *
  * Return: length of string
  */
-size_t _strlen(const char *s)
+NO_ASAN size_t _strlen(const char *s)
 {
-	int i = 0;
+	const char *p = s;
 
 	if (s == NULL)
 	{
 		return (0);
 	}
 
-	while (s[i] != '\0')
+	for (; !word_aligned(p); p++)
 	{
-		i++;
-	}
-
-	return (i);
-}
-
-/**
- * get_operator - returns the && or || logical operator in a string if found
- * @str: the string to search
- *
- * Return: the logical operator if found, else NULL
- */
-char *get_operator(char *str)
-{
-	char *operator = NULL;
-	int i;
-
-	if (str == NULL)
-		return (NULL);
-
-	/* Check for the "&&" operator */
-	for (i = 0; str[i] != '\0'; i++)
-	{
-		if (str[i] == '&' && str[i + 1] == '&')
-		{
-			operator = "&&";
-			break;
-		}
-		/* Check for the "||" operator */
-		else if (str[i] == '|' && str[i + 1] == '|')
-		{
-			operator = "||";
-			break;
-		}
+		if (*p == '\0')
+			return (p - s);
 	}
+	while (!has_zero(*(const word_t *)p))
+		p += WORD_SIZE;
+	while (*p != '\0')
+		p++;
 
-	return (operator);
+	return (p - s);
 }
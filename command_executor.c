@@ -5,14 +5,18 @@
  * @pathname: the absolute path to the binary file to execute
  * @hsh: the shell's context
  *
- * Return: 0 on success, -1 on failure
+ * Description: In a subshell the program replaces the current process, there
+ * is no point in forking once more. The environment is handed over as an
+ * array built before forking, so that it is kept for the next programs.
+ *
+ * Return: the exit code of the program, -1 if it could not be started
  */
 int execute_command(const char *pathname, shell_t *hsh)
 {
+	char **envp = env_envp(&hsh->env, &hsh->arena);
 	int status;
-	pid_t pid;
+	pid_t pid = (hsh->subshell) ? 0 : fork();
 
-	pid = fork();
 	if (pid == -1)
 	{
 		perror("fork");
@@ -21,30 +25,28 @@ int execute_command(const char *pathname, shell_t *hsh)
 
 	if (pid == 0)
 	{
-		if (execve(pathname, hsh->sub_command, environ) == -1)
+		execve(pathname, hsh->sub_command, envp);
+
+		/* only reached if execve failed, the child must not carry on */
+		if (errno == EACCES)
 		{
-			if (errno == EACCES)
-			{
-				fprintf(stderr, "%s: %lu: %s\n", hsh->prog_name,
-						++hsh->cmd_count, strerror(errno));
-				return (126);
-			}
-			perror("execve");
-			return (-1);
+			fprintf(stderr, "%s: %lu: %s: Permission denied\n", hsh->prog_name,
+					hsh->cmd_count, hsh->sub_command[0]);
+			_exit(126);
 		}
+		perror("execve");
+		_exit(CMD_NOT_FOUND);
 	}
-	else
+
+	if (waitpid(pid, &status, 0) == -1)
 	{
-		if (waitpid(pid, &status, 0) == -1)
-		{
-			perror("wait");
-			return (-1);
-		}
-		if (WIFEXITED(status))
-		{
-			return (WEXITSTATUS(status));
-		}
+		perror("wait");
+		return (-1);
 	}
+	if (WIFEXITED(status))
+		return (WEXITSTATUS(status));
+	if (WIFSIGNALED(status))
+		return (128 + WTERMSIG(status));
 
 	return (0);
 }
@@ -0,0 +1,125 @@
+#include "shell.h"
+
+/**
+ * slot_of - finds the slot of a name in the command table
+ * @table: the command table, it has at least one free slot
+ * @name: the interned name
+ *
+ * Description: Interned names are equal when their pointers are, the
+ * pointer is hashed and compared, the characters are never read. Names
+ * interned one after the other sit next to each other, the multiplication
+ * spreads them over the table so they do not pile up in one long run.
+ *
+ * Return: the slot holding the name, or the free slot it would go in
+ */
+static command_t *slot_of(const cmd_table_t *table, const char *name)
+{
+	size_t i = ((size_t)name / ARENA_ALIGN * 2654435761UL) &
+		(table->size - 1);
+
+	while (table->slots[i].name != NULL && table->slots[i].name != name)
+		i = (i + 1) & (table->size - 1);
+
+	return (&table->slots[i]);
+}
+
+/**
+ * grow_commands - doubles the number of slots of the command table
+ * @table: the command table
+ *
+ * Return: 0 on success, -1 if memory ran out
+ */
+static int grow_commands(cmd_table_t *table)
+{
+	cmd_table_t grown;
+	size_t i;
+
+	grown.size = table->size ? table->size * 2 : 32;
+	grown.slots = malloc(grown.size * sizeof(command_t));
+	if (grown.slots == NULL)
+		return (-1);
+	memset(grown.slots, 0, grown.size * sizeof(command_t));
+
+	for (i = 0; i < table->size; i++)
+	{
+		if (table->slots[i].name != NULL)
+			*slot_of(&grown, table->slots[i].name) = table->slots[i];
+	}
+	safe_free(table->slots);
+	table->slots = grown.slots;
+	table->size = grown.size;
+
+	return (0);
+}
+
+/**
+ * find_command - looks a builtin or a function up by name
+ * @table: the command table
+ * @name: the command name
+ *
+ * Description: Builtins and functions share the table, so running a command
+ * takes a single lookup whatever it turns out to be.
+ *
+ * Return: the command, NULL if there is no builtin or function of that name
+ */
+command_t *find_command(const cmd_table_t *table, const char *name)
+{
+	name = find_interned(name);
+
+	return ((name != NULL) ? lookup_command(table, name) : NULL);
+}
+
+/**
+ * lookup_command - looks a builtin or a function up by interned name
+ * @table: the command table
+ * @name: the command name, interned
+ *
+ * Description: The name is not hashed, its pointer is: a command whose name
+ * is interned already is found with a single probe of the table.
+ *
+ * Return: the command, NULL if there is no builtin or function of that name
+ */
+command_t *lookup_command(const cmd_table_t *table, const char *name)
+{
+	command_t *cmd;
+
+	if (table->count == 0)
+		return (NULL);
+	cmd = slot_of(table, name);
+
+	return ((cmd->name != NULL) ? cmd : NULL);
+}
+
+/**
+ * add_command - adds a command name to the command table
+ * @table: the command table
+ * @name: the command name
+ *
+ * Description: The table is kept at most three quarters full. Slots move
+ * when it grows, pointers to commands are only valid until the next call.
+ *
+ * Return: the command of that name, a new one with neither a builtin nor a
+ * function if it was not there, NULL if memory ran out
+ */
+command_t *add_command(cmd_table_t *table, const char *name)
+{
+	command_t *cmd;
+
+	name = intern(name);
+	if (name == NULL ||
+		((table->count + 1) * 4 > table->size * 3 && grow_commands(table) == -1))
+		return (NULL);
+	cmd = slot_of(table, name);
+	if (cmd->name != NULL)
+		return (cmd);
+
+	cmd->name = name;
+	cmd->builtin = -1;
+	cmd->prog = NULL;
+	cmd->start = 0;
+	cmd->alias = 0;
+	cmd->alias_gen = 0;
+	table->count++;
+
+	return (cmd);
+}
@@ -0,0 +1,163 @@
+#include "shell.h"
+
+/**
+ * compile_command - compiles a simple command
+ * @c: the compiler
+ * @cmd: the command node
+ *
+ * Description: Builtins are looked up now, unless the command name has a
+ * variable, break and continue become jumps inside loops, and a command
+ * made of assignments sets its variables without running anything. The
+ * assignments in front of a command only hold while it runs.
+ */
+static void compile_command(compiler_t *c, node_t *cmd)
+{
+	program_t *prog = c->prog;
+	size_t first = prog->n_words, n = count_assigns(cmd);
+	token_t *w = &cmd->words[n], *last = &cmd->words[cmd->n_words - 1];
+	node_t args = *cmd;
+	int32_t offset;
+	int id = -1;
+
+	if (c->loop != NULL && compile_break(c, cmd))
+		return;
+	if (n == cmd->n_words)
+	{
+		compile_assigns(c, cmd, n, OP_ASSIGN);
+		return;
+	}
+	if ((w->len == 5 && !_strncmp(w->start, "alias", 5)) ||
+		(w->len == 7 && !_strncmp(w->start, "unalias", 7)))
+	{
+		/* the alias builtins parse the text of the command themselves */
+		offset = add_string(prog, w->start, last->start + last->len - w->start);
+		emit(prog, OP_ALIAS, offset, 0);
+		return;
+	}
+
+	/* the assignments are expanded after the words, for the command only */
+	args.words = w;
+	args.n_words -= n;
+	compile_args(c, &args, WORD_GLOB);
+	if (n > 0)
+		compile_assigns(c, cmd, n, OP_OVERLAY);
+	if (!(w->flags & (W_DOLLAR | W_GLOB)) && !prog->oom &&
+		prog->n_words > first)
+		id = find_builtin(prog->strings + prog->words[first]);
+	if (id != -1)
+		emit(prog, OP_BUILTIN, id, 0);
+	else
+		emit(prog, OP_EXEC, 0, 0);
+}
+
+/**
+ * compile_pipeline - compiles a pipeline
+ * @c: the compiler
+ * @pipeline: the pipeline node
+ *
+ * Description: A single command is compiled in line. Otherwise each command
+ * becomes a stage, run in its own child, and each stage records where the
+ * next one starts and whether it is a simple command.
+ */
+static void compile_pipeline(compiler_t *c, node_t *pipeline)
+{
+	program_t *prog = c->prog;
+	node_t *cmd = pipeline->child[0];
+	int32_t pipe_at, stage = -1;
+	loop_ctx_t *loop;
+
+	if (cmd->next == NULL && cmd->type == N_COMMAND)
+		compile_command(c, cmd);
+	else if (cmd->next == NULL)
+		compile_compound(c, cmd);
+	else
+	{
+		loop = c->loop;
+		c->loop = NULL; /* stages are subshells, break cannot leave them */
+		pipe_at = emit(prog, OP_PIPE, 0, 0);
+		for (; cmd != NULL; cmd = cmd->next)
+		{
+			if (stage != -1 && !prog->oom)
+				prog->code[stage].a = prog->n_code;
+			stage = emit(prog, OP_STAGE, 0, cmd->type == N_COMMAND);
+			if (cmd->type == N_COMMAND)
+				compile_command(c, cmd);
+			else
+				compile_compound(c, cmd);
+			emit(prog, OP_STAGE_END, 0, 0);
+		}
+		if (!prog->oom)
+			prog->code[stage].a = prog->code[pipe_at].a = prog->n_code;
+		c->loop = loop;
+	}
+
+	if (pipeline->flags & NF_BANG)
+		emit(prog, OP_NOT, 0, 0);
+}
+
+/**
+ * compile_and_or - compiles pipelines joined by '&&' and '||'
+ * @c: the compiler
+ * @and_or: the and-or node
+ *
+ * Description: A failed pipeline followed by '&&' jumps to the next pipeline
+ * that follows a '||', and a successful one followed by '||' to the next
+ * one that follows a '&&'. The jumps wait in two chains until that pipeline
+ * is compiled, or the list ends.
+ */
+void compile_and_or(compiler_t *c, node_t *and_or)
+{
+	program_t *prog = c->prog;
+	int32_t on_failure = -1, on_success = -1;
+	node_t *pipeline;
+	int prev_flags = 0;
+
+	for (pipeline = and_or->child[0]; pipeline != NULL;
+		 pipeline = pipeline->next)
+	{
+		if (prev_flags & NF_OR)
+		{
+			patch_jumps(prog, on_failure, prog->n_code);
+			on_failure = -1;
+		}
+		else if (prev_flags & NF_AND)
+		{
+			patch_jumps(prog, on_success, prog->n_code);
+			on_success = -1;
+		}
+		compile_pipeline(c, pipeline);
+		if (pipeline->flags & NF_AND)
+			on_failure = emit(prog, OP_JNZ, on_failure, 0);
+		else if (pipeline->flags & NF_OR)
+			on_success = emit(prog, OP_JZ, on_success, 0);
+		prev_flags = pipeline->flags;
+	}
+	patch_jumps(prog, on_failure, prog->n_code);
+	patch_jumps(prog, on_success, prog->n_code);
+}
+
+/**
+ * compile_program - compiles a syntax tree to bytecode
+ * @prog: the program, emptied first
+ * @list: the list of and-or lists to compile
+ *
+ * Return: 0 on success, -1 if memory ran out
+ */
+int compile_program(program_t *prog, node_t *list)
+{
+	compiler_t c;
+
+	c.prog = prog;
+	c.loop = NULL;
+	reset_program(prog);
+	compile_list(&c, list);
+	emit(prog, OP_HALT, 0, 0);
+
+	if (prog->oom)
+	{
+		fprintf(stderr, "Not enough system memory to continue\n");
+		return (-1);
+	}
+
+	return (0);
+}
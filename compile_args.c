@@ -0,0 +1,145 @@
+#include "shell.h"
+
+/**
+ * add_word - copies a word of a command to the program
+ * @prog: the program
+ * @word: the word
+ * @glob: WORD_GLOB if the word is globbed once expanded, 0 otherwise
+ *
+ * Description: Words with parameters or wildcards are copied as they were
+ * written and flagged WORD_RAW, the others are unquoted first.
+ *
+ * Return: 1 if the word is expanded when the command runs, 0 otherwise
+ */
+static int add_word(program_t *prog, token_t *word, uint32_t glob)
+{
+	uint32_t raw = (word->flags & (W_DOLLAR | W_GLOB)) ? WORD_RAW : 0;
+	int32_t offset;
+
+	if (!raw)
+		token_word(word);
+	if (grow_buffer(prog, (void **)&prog->words, prog->n_words,
+					&prog->words_size, sizeof(uint32_t)) == -1)
+		return (0);
+	offset = add_string(prog, word->start, word->len);
+	if (offset == -1)
+		return (0);
+	prog->words[prog->n_words++] = (uint32_t)offset | raw | (raw ? glob : 0);
+
+	return (raw != 0);
+}
+
+/**
+ * add_braced - copies the words a word with braces expands to
+ * @prog: the program
+ * @word: the word
+ * @glob: WORD_GLOB if the words are globbed once expanded, 0 otherwise
+ *
+ * Description: Each word keeps the flags of the one written, so the words
+ * that have quotes, parameters or wildcards are handled as it would be.
+ *
+ * Return: 1 if some of the words are expanded when the command runs, 0
+ * otherwise
+ */
+static int add_braced(program_t *prog, token_t *word, uint32_t glob)
+{
+	brace_out_t out = {NULL, 0, 0, 0};
+	token_t tok = *word;
+	size_t off, next;
+	int dollar = 0;
+
+	if (brace_expand(&out, word->start, word->len, 0) == -1)
+	{
+		prog->oom = 1;
+		safe_free(out.buf);
+		return (0);
+	}
+	for (off = 0; off < out.len; off = next)
+	{
+		tok.start = out.buf + off;
+		tok.len = _strlen(tok.start);
+		tok.flags = word->flags & ~W_BRACE;
+		next = off + tok.len + 1;
+		dollar |= add_word(prog, &tok, glob);
+	}
+	safe_free(out.buf);
+
+	return (dollar);
+}
+
+/**
+ * compile_args - compiles the building of a command's arguments
+ * @c: the compiler
+ * @cmd: the command node
+ * @glob: WORD_GLOB if the words are brace expanded now and globbed once
+ *        expanded, 0 for the word of a case
+ *
+ * Description: The words are unquoted once, here, and copied to the
+ * program, so building the arguments only points them at the copies.
+ * Words with parameters or wildcards are copied as they were written and
+ * flagged WORD_RAW: they are unquoted as they are expanded, and globbed,
+ * when the command runs. Braces come before any of that and only depend
+ * on the text, so a word with braces becomes its words here.
+ */
+void compile_args(compiler_t *c, node_t *cmd, uint32_t glob)
+{
+	program_t *prog = c->prog;
+	size_t i, first = prog->n_words;
+	int dollar = 0;
+
+	for (i = 0; i < cmd->n_words; i++)
+	{
+		if (glob && (cmd->words[i].flags & W_BRACE))
+			dollar |= add_braced(prog, &cmd->words[i], glob);
+		else
+			dollar |= add_word(prog, &cmd->words[i], glob);
+	}
+
+	emit(prog, dollar ? OP_EXPAND : OP_ARGV, first, prog->n_words - first);
+}
+
+/**
+ * count_assigns - counts the assignments in front of a command
+ * @cmd: the command node
+ *
+ * Description: An assignment is a word that starts with a name and '=',
+ * unquoted.
+ *
+ * Return: the number of assignments, that of the words if the command is
+ * made of nothing else
+ */
+size_t count_assigns(const node_t *cmd)
+{
+	const char *eq;
+	size_t n;
+
+	for (n = 0; n < cmd->n_words; n++)
+	{
+		eq = memchr(cmd->words[n].start, '=', cmd->words[n].len);
+		if (eq == NULL || !is_name(cmd->words[n].start,
+								   eq - cmd->words[n].start))
+			break;
+	}
+
+	return (n);
+}
+
+/**
+ * compile_assigns - compiles the assignments in front of a command
+ * @c: the compiler
+ * @cmd: the command node
+ * @n: number of assignments
+ * @op: OP_ASSIGN if the command is made of nothing else, OP_OVERLAY if
+ *      they are for the command only
+ *
+ * Description: The values are neither split, brace expanded nor globbed.
+ */
+void compile_assigns(compiler_t *c, node_t *cmd, size_t n, int32_t op)
+{
+	program_t *prog = c->prog;
+	size_t i, first = prog->n_words;
+
+	for (i = 0; i < n; i++)
+		add_word(prog, &cmd->words[i], 0);
+	emit(prog, op, first, prog->n_words - first);
+}
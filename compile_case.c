@@ -0,0 +1,179 @@
+#include "shell.h"
+
+/**
+ * scan_pattern - tells what kind of pattern a word is, and builds it
+ * @tok: the pattern's token, not expanded
+ * @buf: where to build the pattern, large enough for twice the token, or
+ *       NULL to only find its kind
+ *
+ * Description: Quoted and escaped characters match as they are, so the
+ * quotes are removed and the wildcards among them are escaped.
+ *
+ * Return: OP_GLOBVAR if the pattern holds a parameter (@buf is not built),
+ * OP_GLOB if it has wildcards, OP_ARM if it is a literal string
+ */
+static int scan_pattern(const token_t *tok, char *buf)
+{
+	char *p = tok->start, *end = tok->start + tok->len, quote = 0;
+	int op = OP_ARM;
+
+	if (tok->flags & W_DOLLAR)
+		return (OP_GLOBVAR);
+	for (; p < end; p++)
+	{
+		if ((quote == 0 && isquote(*p)) || (quote != 0 && *p == quote))
+		{
+			quote = (quote == 0) ? *p : 0;
+			continue;
+		}
+		if (*p == '\\' && quote != '\'' && p + 1 < end &&
+			(quote == 0 || _strchr("\\\"$`", p[1]) != NULL))
+			p++;
+		else if (quote == 0 && (*p == '*' || *p == '?' || *p == '['))
+		{
+			op = OP_GLOB;
+			if (buf != NULL)
+				*buf++ = *p;
+			continue;
+		}
+		if (buf != NULL && (*p == '*' || *p == '?' || *p == '[' || *p == '\\'))
+			*buf++ = '\\';
+		if (buf != NULL)
+			*buf++ = *p;
+	}
+	if (buf != NULL)
+		*buf = '\0';
+
+	return (op);
+}
+
+/**
+ * compile_pattern - copies a pattern to the program
+ * @prog: the program
+ * @tok: the pattern's token
+ * @op: where to store the pattern's kind (see scan_pattern)
+ *
+ * Return: the offset of the pattern in the strings, -1 if memory ran out.
+ * Literal patterns are stored unescaped, the ones with parameters as they
+ * were written, the others as patterns.
+ */
+static int32_t compile_pattern(program_t *prog, token_t *tok, int *op)
+{
+	char *buf;
+	int32_t offset;
+
+	*op = scan_pattern(tok, NULL);
+	if (*op != OP_GLOB)
+	{
+		if (*op == OP_ARM)
+			token_word(tok);
+		return (add_string(prog, tok->start, tok->len));
+	}
+
+	buf = malloc(tok->len * 2 + 1);
+	if (buf == NULL)
+	{
+		prog->oom = 1;
+		return (-1);
+	}
+	scan_pattern(tok, buf);
+	offset = add_string(prog, buf, _strlen(buf));
+	safe_free(buf);
+
+	return (offset);
+}
+
+/**
+ * add_literal - adds a literal pattern to the hash table of a case command
+ * @prog: the program
+ * @slots: the table's first slot
+ * @n_slots: number of slots, a power of two, at least one is free
+ * @str: offset of the pattern
+ * @target: the arm's first instruction
+ */
+static void add_literal(program_t *prog, int32_t slots, int32_t n_slots,
+						int32_t str, int32_t target)
+{
+	size_t i = hash_name(prog->strings + str) & (n_slots - 1);
+	insn_t *slot;
+
+	for (;; i = (i + 1) & (n_slots - 1))
+	{
+		slot = &prog->code[slots + i];
+		if (slot->a == -1)
+		{
+			slot->a = str;
+			slot->b = target;
+			return;
+		}
+		if (!_strcmp(prog->strings + slot->a, prog->strings + str))
+			return; /* an earlier arm has it, it comes first */
+	}
+}
+
+/**
+ * compile_case - compiles a case command
+ * @c: the compiler
+ * @node: the case node
+ *
+ * Description: OP_CASE is followed by the table of the arms: a hash table
+ * of the literal patterns, then the other patterns in the order they were
+ * written. Each entry holds the first instruction of its arm. The first
+ * arm that matches wins, so the earlier arms are tried in order when
+ * wildcards are involved: literal arms take a single lookup whatever
+ * their number.
+ */
+void compile_case(compiler_t *c, node_t *node)
+{
+	program_t *prog = c->prog;
+	int32_t slots, globs, n_slots = 0, n_globs = 0, to_end, str;
+	node_t *arm;
+	size_t i, n_literals = 0;
+	int op;
+
+	compile_args(c, node, 0); /* the word is not globbed */
+	for (arm = node->child[0]; arm != NULL; arm = arm->next)
+	{
+		for (i = 0; i < arm->n_words; i++)
+		{
+			if (scan_pattern(&arm->words[i * 2], NULL) == OP_ARM)
+				n_literals++;
+			else
+				n_globs++;
+		}
+	}
+	while (n_literals > 0 && (size_t)n_slots < n_literals * 2)
+		n_slots = n_slots ? n_slots * 2 : 8;
+
+	emit(prog, OP_CASE, n_slots, n_globs);
+	for (slots = prog->n_code, i = 0; i < (size_t)n_slots; i++)
+		emit(prog, OP_ARM, -1, 0);
+	for (globs = prog->n_code, i = 0; i < (size_t)n_globs; i++)
+		emit(prog, OP_GLOB, 0, 0);
+	emit(prog, OP_SET, 0, 0); /* no arm matched */
+	to_end = emit(prog, OP_JMP, -1, 0);
+
+	for (arm = node->child[0]; arm != NULL && !prog->oom; arm = arm->next)
+	{
+		for (i = 0; i < arm->n_words; i++)
+		{
+			str = compile_pattern(prog, &arm->words[i * 2], &op);
+			if (str == -1 || prog->oom)
+				return;
+			if (op == OP_ARM)
+				add_literal(prog, slots, n_slots, str, prog->n_code);
+			else
+			{
+				prog->code[globs].op = op;
+				prog->code[globs].a = str;
+				prog->code[globs++].b = prog->n_code;
+			}
+		}
+		if (arm->child[0] != NULL)
+			compile_list(c, arm->child[0]);
+		else
+			emit(prog, OP_SET, 0, 0);
+		to_end = emit(prog, OP_JMP, to_end, 0);
+	}
+	patch_jumps(prog, to_end, prog->n_code);
+}
@@ -0,0 +1,118 @@
+#include "shell.h"
+
+/**
+ * patch_jumps - points a chain of jumps at their target
+ * @prog: the program
+ * @chain: the last jump of the chain, each jump's operand holds the previous
+ *         one until it is patched, -1 ends the chain
+ * @target: the target
+ */
+void patch_jumps(program_t *prog, int32_t chain, int32_t target)
+{
+	int32_t prev;
+
+	while (chain != -1 && !prog->oom)
+	{
+		prev = prog->code[chain].a;
+		prog->code[chain].a = target;
+		chain = prev;
+	}
+}
+
+/**
+ * compile_list - compiles the and-or lists of a list
+ * @c: the compiler
+ * @list: the list node
+ */
+void compile_list(compiler_t *c, node_t *list)
+{
+	node_t *and_or;
+
+	for (and_or = list->child[0]; and_or != NULL; and_or = and_or->next)
+		compile_and_or(c, and_or);
+}
+
+/**
+ * compile_if - compiles an if command
+ * @c: the compiler
+ * @node: the if node
+ *
+ * Description: elif parts are compiled in the same loop, each failed
+ * condition jumps to the next one, and each part that ran jumps to the
+ * end. When no part runs, the exit code is 0.
+ */
+static void compile_if(compiler_t *c, node_t *node)
+{
+	program_t *prog = c->prog;
+	int32_t to_else, to_end = -1;
+
+	for (;;)
+	{
+		compile_list(c, node->child[0]);
+		to_else = emit(prog, OP_JNZ, -1, 0);
+		compile_list(c, node->child[1]);
+		to_end = emit(prog, OP_JMP, to_end, 0);
+		patch_jumps(prog, to_else, prog->n_code);
+		if (node->child[2] == NULL)
+		{
+			emit(prog, OP_SET, 0, 0);
+			break;
+		}
+		if (node->child[2]->type != N_IF)
+		{
+			compile_list(c, node->child[2]);
+			break;
+		}
+		node = node->child[2];
+	}
+	patch_jumps(prog, to_end, prog->n_code);
+}
+
+/**
+ * compile_function - compiles a function definition
+ * @c: the compiler
+ * @node: the function node
+ *
+ * Description: The body is compiled in line, after the OP_DEFUN defining
+ * the function, which jumps over it. The body ends with its own OP_HALT,
+ * a call runs it from its first instruction until there.
+ */
+static void compile_function(compiler_t *c, node_t *node)
+{
+	program_t *prog = c->prog;
+	loop_ctx_t *loop = c->loop;
+	int32_t name, defun;
+
+	name = add_string(prog, node->words->start, node->words->len);
+	defun = emit(prog, OP_DEFUN, 0, name);
+	c->loop = NULL; /* break cannot leave the function */
+	compile_compound(c, node->child[0]);
+	emit(prog, OP_HALT, 0, 0);
+	c->loop = loop;
+	if (!prog->oom)
+		prog->code[defun].a = prog->n_code;
+}
+
+/**
+ * compile_compound - compiles a compound command
+ * @c: the compiler
+ * @node: the command's node
+ */
+void compile_compound(compiler_t *c, node_t *node)
+{
+	if (node->type == N_GROUP)
+		compile_list(c, node->child[0]);
+	else if (node->type == N_FUNCTION)
+		compile_function(c, node);
+	else if (node->type == N_IF)
+		compile_if(c, node);
+	else if (node->type == N_WHILE)
+		compile_while(c, node);
+	else if (node->type == N_FOR)
+		compile_for(c, node);
+	else if (node->type == N_CASE)
+		compile_case(c, node);
+	else if (node->type == N_ARITH)
+		emit(c->prog, OP_ARITH, add_string(c->prog, node->words->start,
+										   node->words->len), 0);
+}
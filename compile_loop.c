@@ -0,0 +1,142 @@
+#include "shell.h"
+
+/**
+ * begin_loop - enters a loop being compiled
+ * @c: the compiler
+ * @loop: the loop's context
+ */
+static void begin_loop(compiler_t *c, loop_ctx_t *loop)
+{
+	loop->breaks = -1;
+	loop->continues = -1;
+	loop->outer = c->loop;
+	c->loop = loop;
+}
+
+/**
+ * end_loop - leaves a loop being compiled, once its OP_ENDLOOP is emitted
+ * @c: the compiler
+ * @loop: the loop's context
+ * @save: the loop's OP_SAVE, where continue goes
+ *
+ * Description: break goes past the OP_ENDLOOP, it ends the loop itself.
+ */
+static void end_loop(compiler_t *c, loop_ctx_t *loop, int32_t save)
+{
+	patch_jumps(c->prog, loop->breaks, c->prog->n_code);
+	patch_jumps(c->prog, loop->continues, save);
+	c->loop = loop->outer;
+}
+
+/**
+ * compile_while - compiles a while or until loop
+ * @c: the compiler
+ * @node: the loop node
+ *
+ * Description: The condition and the body are compiled once, each
+ * iteration jumps back to the condition.
+ */
+void compile_while(compiler_t *c, node_t *node)
+{
+	program_t *prog = c->prog;
+	int32_t cond, done, save;
+	loop_ctx_t loop;
+
+	emit(prog, OP_LOOP, 0, 0);
+	begin_loop(c, &loop);
+	cond = prog->n_code;
+	compile_list(c, node->child[0]);
+	done = emit(prog, (node->flags & NF_UNTIL) ? OP_JZ : OP_JNZ, -1, 0);
+	compile_list(c, node->child[1]);
+	save = emit(prog, OP_SAVE, 0, 0);
+	emit(prog, OP_JMP, cond, 0);
+	patch_jumps(prog, done, prog->n_code);
+	emit(prog, OP_ENDLOOP, 0, 0);
+	end_loop(c, &loop, save);
+}
+
+/**
+ * compile_for - compiles a for loop
+ * @c: the compiler
+ * @node: the loop node
+ *
+ * Description: The words are expanded once, when the loop starts, then
+ * OP_NEXT assigns them to the variable one after the other. Without 'in',
+ * the loop goes over the positional parameters. A loop over a single
+ * sequence, as "{1..1000000}", makes its words one at a time instead.
+ */
+void compile_for(compiler_t *c, node_t *node)
+{
+	program_t *prog = c->prog;
+	token_t *w = (node->child[1] != NULL) ? node->child[1]->words : NULL;
+	int32_t name, next, save;
+	size_t open, close;
+	brace_range_t range;
+	loop_ctx_t loop;
+
+	if (w != NULL && node->child[1]->n_words == 1 && w->flags == W_BRACE &&
+		brace_sequence(w->start, w->len, &open, &close, &range))
+		emit(prog, OP_LOOP, 2, add_string(prog, w->start, w->len));
+	else
+	{
+		if (node->child[1] != NULL)
+			compile_args(c, node->child[1], WORD_GLOB);
+		else
+			emit(prog, OP_PARAMS, 0, 0); /* 'for x' loops over "$@" */
+		emit(prog, OP_LOOP, 1, 0);
+	}
+	begin_loop(c, &loop);
+	name = add_string(prog, node->words->start, node->words->len);
+	next = emit(prog, OP_NEXT, -1, name);
+	compile_list(c, node->child[0]);
+	save = emit(prog, OP_SAVE, 0, 0);
+	emit(prog, OP_JMP, next, 0);
+	patch_jumps(prog, next, prog->n_code);
+	emit(prog, OP_ENDLOOP, 0, 0);
+	end_loop(c, &loop, save);
+}
+
+/**
+ * compile_break - compiles break and continue inside a loop
+ * @c: the compiler
+ * @cmd: the command node
+ *
+ * Description: 'break n' leaves the n innermost loops (all of them if
+ * there are fewer) and 'continue n' goes on with the next iteration of the
+ * n-th one. Commands with other arguments are left to the builtins.
+ *
+ * Return: 1 if the command was compiled, 0 if it is not one of them
+ */
+int compile_break(compiler_t *c, node_t *cmd)
+{
+	token_t *w = cmd->words;
+	loop_ctx_t *loop = c->loop;
+	int is_continue, n = 0, levels = 1;
+	size_t i;
+
+	if (w->flags != 0 || cmd->n_words > 2)
+		return (0);
+	if (w->len == 5 && !_strncmp(w->start, "break", 5))
+		is_continue = 0;
+	else if (w->len == 8 && !_strncmp(w->start, "continue", 8))
+		is_continue = 1;
+	else
+		return (0);
+	for (i = 0; cmd->n_words == 2 && i < w[1].len && n < 10000; i++)
+	{
+		if (w[1].flags != 0 || !isdigit(w[1].start[i]))
+			return (0);
+		n = n * 10 + (w[1].start[i] - '0');
+	}
+	if (cmd->n_words == 2 && n == 0)
+		return (0);
+
+	for (; n > 1 && loop->outer != NULL; n--, levels++)
+		loop = loop->outer;
+	if (is_continue)
+		loop->continues = emit(c->prog, OP_BREAK, loop->continues, levels - 1);
+	else
+		loop->breaks = emit(c->prog, OP_BREAK, loop->breaks, levels);
+
+	return (1);
+}
@@ -0,0 +1,152 @@
+#include "shell.h"
+
+/**
+ * _setenv - sets an environment variable, exported
+ * @env: the variable table
+ * @name: the variable's name
+ * @value: its value
+ *
+ * Return: 0 on success, -1 if the name is not valid, the variable is
+ * read-only or memory ran out
+ */
+int _setenv(env_t *env, const char *name, const char *value)
+{
+	if (name == NULL || *name == '\0' || _strchr(name, '=') != NULL)
+		return (-1);
+
+	return (set_var(env, name, _strlen(name), value, VAR_EXPORT) ? -1 : 0);
+}
+
+/**
+ * _unsetenv - removes a variable
+ * @env: the variable table
+ * @name: the variable's name
+ *
+ * Description: The variables that come after it in its run of slots are
+ * shifted back into the gap when they can go there, so that lookups never
+ * have to step over removed variables.
+ *
+ * Return: 0 on success, 1 if the variable is not set, -1 if it is read-only
+ */
+int _unsetenv(env_t *env, const char *name)
+{
+	size_t len = _strlen(name), mask = env->size - 1, hole, i, home;
+	env_var_t *var;
+
+	if (env->size == 0)
+		return (1);
+	var = env_slot(env, name, len, hash_text(name, len));
+	if (var->entry == NULL)
+		return (1);
+	if (var->flags & VAR_READONLY)
+		return (-1);
+	safe_free(var->entry);
+	env->count--;
+	env->gen++;
+	env->stale |= var_exported(var->flags);
+
+	hole = var - env->slots;
+	for (i = (hole + 1) & mask; env->slots[i].entry != NULL; i = (i + 1) & mask)
+	{
+		home = env->slots[i].hash & mask;
+		/* it may move back unless its home is between the gap and it */
+		if ((i > hole) ? (home <= hole || home > i) : (home <= hole && home > i))
+		{
+			env->slots[hole] = env->slots[i];
+			env->slots[i].entry = NULL;
+			hole = i;
+		}
+	}
+
+	return (0);
+}
+
+/**
+ * restore_var - puts a variable back as it was, value and attributes
+ * @env: the variable table
+ * @name: the variable's name
+ * @value: its value, NULL if it was declared without one
+ * @flags: its attributes, -1 if it was not set at all
+ *
+ * Description: Whatever was done to the variable since is undone, it being
+ * made read-only included.
+ *
+ * Return: 0 on success, -1 if memory ran out
+ */
+int restore_var(env_t *env, const char *name, const char *value, int flags)
+{
+	size_t len = _strlen(name);
+	env_var_t *var = find_var(env, name, len);
+
+	if (var != NULL)
+		var->flags &= ~VAR_READONLY;
+	if (flags == -1)
+		return ((_unsetenv(env, name) == -1) ? -1 : 0);
+	if (set_var(env, name, len, value, 0) == -1)
+		return (-1);
+	var = find_var(env, name, len);
+	if (var_exported(var->flags) != var_exported(flags))
+		env->stale = 1;
+	var->flags = flags;
+
+	return (0);
+}
+
+/**
+ * env_envp - gives the environment as execve() takes it
+ * @env: the variable table
+ * @arena: where to build it when assignments are in front of the command
+ *
+ * Description: The array points to the entries of the exported variables,
+ * it is built when a program is run and kept until one is added or
+ * removed. Values changed in place show through it. The assignments in
+ * front of the command are put over it in an array of its own.
+ *
+ * Return: the NULL-terminated array of "NAME=value" entries, an empty one
+ * if memory ran out
+ */
+char **env_envp(env_t *env, arena_t *arena)
+{
+	static char *empty[] = {NULL};
+	size_t i, n = 0;
+	char **envp;
+
+	if (env->envp == NULL || env->stale)
+	{
+		envp = malloc((env->count + 1) * sizeof(char *));
+		if (envp == NULL)
+			return (empty);
+		for (i = 0; i < env->size; i++)
+		{
+			if (env->slots[i].entry != NULL &&
+				var_exported(env->slots[i].flags))
+				envp[n++] = env->slots[i].entry;
+		}
+		envp[n] = NULL;
+		safe_free(env->envp);
+		env->envp = envp;
+		env->stale = 0;
+	}
+	if (env->n_overlay == 0)
+		return (env->envp);
+	envp = overlay_envp(env, arena);
+
+	return ((envp != NULL) ? envp : empty);
+}
+
+/**
+ * free_env - releases the variable table
+ * @env: the table
+ */
+void free_env(env_t *env)
+{
+	size_t i;
+
+	for (i = 0; i < env->size; i++)
+		safe_free(env->slots[i].entry);
+	safe_free(env->slots);
+	safe_free(env->envp);
+	safe_free(env->overlay);
+	env->size = env->count = env->n_overlay = env->overlay_size = 0;
+	env->stale = 0;
+}
@@ -0,0 +1,113 @@
+#include "shell.h"
+
+/**
+ * same_name - tells whether two "NAME=value" entries set the same name
+ * @a: the first entry
+ * @b: the second entry
+ *
+ * Return: 1 if they do, 0 otherwise
+ */
+static int same_name(const char *a, const char *b)
+{
+	for (; *a == *b && *a != '='; a++, b++)
+		;
+
+	return (*a == '=' && *b == '=');
+}
+
+/**
+ * push_overlay - adds an assignment for the command about to run
+ * @env: the variable table
+ * @entry: the assignment, "NAME=value", kept until the command is done
+ *
+ * Return: 0 on success, -1 if memory ran out
+ */
+int push_overlay(env_t *env, char *entry)
+{
+	size_t size = env->overlay_size ? env->overlay_size * 2 : ENV_MIN;
+	char **overlay;
+
+	if (env->n_overlay == env->overlay_size)
+	{
+		overlay = _realloc(env->overlay, env->overlay_size * sizeof(char *),
+						   size * sizeof(char *));
+		if (overlay == NULL)
+			return (-1);
+		env->overlay = overlay;
+		env->overlay_size = size;
+	}
+	env->overlay[env->n_overlay++] = entry;
+
+	return (0);
+}
+
+/**
+ * find_overlay - looks a variable up in the assignments of the running
+ * commands
+ * @env: the variable table
+ * @name: the name, not necessarily NUL-terminated
+ * @len: length of the name
+ *
+ * Return: the value of the innermost assignment of the name, NULL if none
+ * sets it
+ */
+char *find_overlay(const env_t *env, const char *name, size_t len)
+{
+	size_t i;
+
+	for (i = env->n_overlay; i > 0; i--)
+	{
+		if (!_strncmp(env->overlay[i - 1], name, len) &&
+			env->overlay[i - 1][len] == '=')
+			return (env->overlay[i - 1] + len + 1);
+	}
+
+	return (NULL);
+}
+
+/**
+ * overlay_envp - builds the environment of a command run with assignments
+ * @env: the variable table, its envp up to date
+ * @arena: where to build it, it lives as long as the command
+ *
+ * Description: The exported variables are taken from the cached envp, but
+ * those the assignments set, then the assignments are added, each but
+ * those set again by one after it. The table is not changed, there is
+ * nothing to undo once the command is done.
+ *
+ * Return: the NULL-terminated array, NULL if memory ran out
+ */
+char **overlay_envp(const env_t *env, arena_t *arena)
+{
+	size_t n_base, i, j, n = 0;
+	char **envp;
+
+	for (n_base = 0; env->envp[n_base] != NULL; n_base++)
+		;
+	envp = arena_alloc(arena, (n_base + env->n_overlay + 1) * sizeof(char *));
+	if (envp == NULL)
+		return (NULL);
+	for (i = 0; i < n_base; i++)
+	{
+		for (j = 0; j < env->n_overlay; j++)
+		{
+			if (same_name(env->envp[i], env->overlay[j]))
+				break;
+		}
+		if (j == env->n_overlay)
+			envp[n++] = env->envp[i];
+	}
+	for (i = 0; i < env->n_overlay; i++)
+	{
+		for (j = i + 1; j < env->n_overlay; j++)
+		{
+			if (same_name(env->overlay[i], env->overlay[j]))
+				break;
+		}
+		if (j == env->n_overlay)
+			envp[n++] = env->overlay[i];
+	}
+	envp[n] = NULL;
+
+	return (envp);
+}
@@ -0,0 +1,172 @@
+#include "shell.h"
+
+/**
+ * env_slot - finds the slot of a variable in the variable table
+ * @env: the table, it has at least one free slot
+ * @name: the name, not necessarily NUL-terminated
+ * @len: length of the name
+ * @hash: the name's hash
+ *
+ * Return: the slot holding the variable, or the free slot it would go in
+ */
+env_var_t *env_slot(const env_t *env, const char *name, size_t len,
+					unsigned long hash)
+{
+	size_t i = hash & (env->size - 1);
+	env_var_t *var;
+
+	for (var = &env->slots[i]; var->entry != NULL; var = &env->slots[i])
+	{
+		if (var->hash == hash && var->name_len == len &&
+			!_strncmp(var->entry, name, len))
+			break;
+		i = (i + 1) & (env->size - 1);
+	}
+
+	return (var);
+}
+
+/**
+ * grow_env - doubles the number of slots of the variable table
+ * @env: the table
+ *
+ * Description: The entries do not move, an array built for execve() is
+ * still good afterwards.
+ *
+ * Return: 0 on success, -1 if memory ran out
+ */
+static int grow_env(env_t *env)
+{
+	env_var_t *old = env->slots;
+	size_t i, old_size = env->size;
+
+	env->size = old_size ? old_size * 2 : ENV_MIN;
+	env->slots = calloc(env->size, sizeof(env_var_t));
+	if (env->slots == NULL)
+	{
+		env->slots = old;
+		env->size = old_size;
+		return (-1);
+	}
+
+	for (i = 0; i < old_size; i++)
+	{
+		if (old[i].entry != NULL)
+			*env_slot(env, old[i].entry, old[i].name_len, old[i].hash) = old[i];
+	}
+	safe_free(old);
+
+	return (0);
+}
+
+/**
+ * put_value - writes the value of a variable
+ * @env: the table
+ * @var: the variable's slot, free if it is not set
+ * @name: the name, not necessarily NUL-terminated
+ * @len: length of the name
+ * @value: the value
+ *
+ * Description: A value that fits in the variable's entry is written over
+ * the old one, so that loops setting the same variable again and again do
+ * not allocate, and the array built for execve() stays good.
+ *
+ * Return: 0 on success, -1 if memory ran out
+ */
+static int put_value(env_t *env, env_var_t *var, const char *name,
+					 size_t len, const char *value)
+{
+	size_t value_len = _strlen(value), need = len + value_len + 2;
+	char *entry;
+
+	env->gen++;
+	if (var->entry != NULL && var->size >= need)
+	{
+		/* the value may come from the entry itself */
+		memmove(var->entry + len + 1, value, value_len + 1);
+		return (0);
+	}
+	entry = malloc(need);
+	if (entry == NULL)
+		return (-1);
+	_memcpy(entry, name, len);
+	entry[len] = '=';
+	_memcpy(entry + len + 1, value, value_len + 1);
+	if (var->entry == NULL)
+		env->count++;
+	else if (var_exported(var->flags))
+		env->stale = 1;
+	safe_free(var->entry);
+	var->entry = entry;
+	var->size = need;
+
+	return (0);
+}
+
+/**
+ * set_var - sets a variable, or adds attributes to it
+ * @env: the table
+ * @name: the name, not necessarily NUL-terminated
+ * @len: length of the name
+ * @value: the value, NULL to only add @flags, to a variable declared
+ *         without a value if it is not set
+ * @flags: attributes to add (VAR_EXPORT, VAR_READONLY)
+ *
+ * Description: A new variable is not exported unless @flags says so, an
+ * existing one keeps its attributes.
+ *
+ * Return: 0 on success, 1 if the variable is read-only, -1 if memory ran out
+ */
+int set_var(env_t *env, const char *name, size_t len, const char *value,
+			int flags)
+{
+	unsigned long hash = hash_text(name, len);
+	env_var_t *var;
+	int old;
+
+	if ((env->count + 1) * 2 > env->size && grow_env(env) == -1)
+		return (-1);
+	var = env_slot(env, name, len, hash);
+	old = (var->entry != NULL) ? var->flags : VAR_UNSET;
+	if (value != NULL && (old & VAR_READONLY))
+		return (1);
+	if (var->entry == NULL)
+	{
+		var->name_len = len;
+		var->hash = hash;
+		var->flags = old;
+	}
+	if ((value != NULL || var->entry == NULL) &&
+		put_value(env, var, name, len, (value != NULL) ? value : "") == -1)
+		return (-1);
+	var->flags = (value != NULL) ? (old & ~VAR_UNSET) | flags : old | flags;
+	if (var_exported(var->flags) != var_exported(old))
+		env->stale = 1;
+
+	return (0);
+}
+
+/**
+ * init_env - fills the shell's variables with the environment it was
+ * started with, exported
+ * @env: the table, zeroed
+ * @envp: the inherited environment
+ *
+ * Return: 0 on success, -1 if memory ran out
+ */
+int init_env(env_t *env, char **envp)
+{
+	char *eq;
+
+	if (grow_env(env) == -1)
+		return (-1);
+	for (; envp != NULL && *envp != NULL; envp++)
+	{
+		eq = _strchr(*envp, '=');
+		if (eq != NULL && eq > *envp &&
+			set_var(env, *envp, eq - *envp, eq + 1, VAR_EXPORT) == -1)
+			return (-1);
+	}
+
+	return (0);
+}
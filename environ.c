@@ -1,43 +1,78 @@
 #include "shell.h"
 
 /**
- * _getenv - get an environment variable
- * @name: the name of the environment variable to look for
+ * _getenv - get a variable
+ * @env: the variable table
+ * @name: the name of the variable to look for
  *
- * Return: a pointer to the value in the environment,
+ * Return: a pointer to the value in the table,
  * or NULL if there is no match
  */
-char *_getenv(const char *name)
+char *_getenv(const env_t *env, const char *name)
 {
-	int i;
-	size_t len = _strlen(name);
+	return (find_env(env, name, _strlen(name)));
+}
 
-	for (i = 0; environ[i] != NULL; i++)
-	{
-		/* check if we found a match */
-		if (_strstr(environ[i], name) && environ[i][len] == '=')
-		{
-			/* move past the equal to sign and return the actual value */
-			return ((_strchr(environ[i], '=')) + 1);
-		}
-	}
+/**
+ * find_env - get a variable, named by the start of a string
+ * @env: the variable table
+ * @name: the name, not necessarily NUL-terminated
+ * @len: length of the name
+ *
+ * Return: a pointer to the value in the table,
+ * or NULL if there is no match
+ */
+char *find_env(const env_t *env, const char *name, size_t len)
+{
+	env_var_t *var;
+	char *value;
+
+	/* the assignments in front of the running commands come first */
+	if (env->n_overlay > 0 && (value = find_overlay(env, name, len)) != NULL)
+		return (value);
+	var = find_var(env, name, len);
+	if (var == NULL || (var->flags & VAR_UNSET))
+		return (NULL);
+
+	/* the value is past the equal to sign */
+	return (var->entry + len + 1);
+}
+
+/**
+ * find_var - looks a variable up in the table, past the assignments in
+ * front of the running commands
+ * @env: the variable table
+ * @name: the name, not necessarily NUL-terminated
+ * @len: length of the name
+ *
+ * Return: the variable, declared without a value too, NULL if the table
+ * does not have it
+ */
+env_var_t *find_var(const env_t *env, const char *name, size_t len)
+{
+	env_var_t *var;
+
+	if (env->size == 0)
+		return (NULL);
+	var = env_slot(env, name, len, hash_text(name, len));
 
-	return (NULL);
+	return ((var->entry != NULL) ? var : NULL);
 }
 
 /**
  * build_path - builds a list of paths in the PATH environment variable
+ * @env: the variable table
  * @head: a pointer to the head node
  *
  * Return: a pointer to the head onn success, else NULL on failure.
  */
-path_t *build_path(path_t **head)
+path_t *build_path(const env_t *env, path_t **head)
 {
 	size_t i = 0;
 	char *path_value = NULL, **pathnames = NULL;
 	path_t *new_node = NULL, *tail = NULL;
 
-	path_value = _getenv("PATH");
+	path_value = _getenv(env, "PATH");
 	if (path_value == NULL || *path_value == '\0')
 		return (NULL); /* PATH is not set */
 
@@ -0,0 +1,238 @@
+#include "shell.h"
+
+/**
+ * put_text - appends text to the word being expanded
+ * @x: the expansion buffers
+ * @s: the text
+ * @len: length of the text
+ * @quoted: non-zero if the text is quoted; in patterns, it then matches as
+ *          it is, so its wildcards are escaped
+ *
+ * Description: The buffer grows by doubling, once it is large enough for
+ * the longest word it is never allocated again.
+ *
+ * Return: 0 on success, -1 if memory ran out
+ */
+static int put_text(expand_t *x, const char *s, size_t len, int quoted)
+{
+	size_t need = x->len + len * ((x->pattern && quoted) ? 2 : 1) + 1, size;
+	char *buf;
+
+	if (need > x->size)
+	{
+		size = (need * 2 > EXPAND_MIN) ? need * 2 : EXPAND_MIN;
+		buf = _realloc(x->buf, x->len, size);
+		if (buf == NULL)
+		{
+			fprintf(stderr, "Not enough system memory to continue\n");
+			return (-1);
+		}
+		x->buf = buf;
+		x->size = size;
+	}
+	if (!x->pattern || !quoted)
+	{
+		_memcpy(x->buf + x->len, s, len);
+		x->len += len;
+		return (0);
+	}
+	for (; len > 0; len--, s++)
+	{
+		if (*s == '*' || *s == '?' || *s == '[' || *s == '\\')
+			x->buf[x->len++] = '\\';
+		x->buf[x->len++] = *s;
+	}
+
+	return (0);
+}
+
+/**
+ * end_field - ends the field being expanded
+ * @x: the expansion buffers
+ *
+ * Description: A field left empty is dropped, unless it had quotes.
+ *
+ * Return: 0 on success, -1 if memory ran out
+ */
+static int end_field(expand_t *x)
+{
+	if (x->len == x->start && !x->keep)
+		return (0);
+	if (put_text(x, "", 1, 0) == -1)
+		return (-1);
+	x->start = x->len;
+	x->done++;
+	x->keep = 0;
+
+	return (0);
+}
+
+/**
+ * scan_param - finds the parameter following a '$'
+ * @p: the byte following the '$'
+ * @name: where to store the start of the parameter's name
+ * @len: where to store the length of the name, 0 if the '$' is literal
+ *
+ * Description: A name is made of letters, digits and underscores and does
+ * not start with a digit. The other parameters are a digit or one of
+ * "#?$@*". Between braces, digits go on to form larger numbers.
+ *
+ * Return: a pointer past the parameter, NULL if braces are not closed right
+ * after a parameter
+ */
+const char *scan_param(const char *p, const char **name, size_t *len)
+{
+	int braced = (*p == '{');
+	const char *end = p + braced;
+
+	*name = end;
+	if (*end != '\0' && _strchr("#?$@*", *end) != NULL)
+		end++;
+	else if (isdigit(*end))
+	{
+		for (end++; braced && isdigit(*end); end++)
+			;
+	}
+	else if (isalpha(*end) || *end == '_')
+	{
+		for (end++; isalpha(*end) || isdigit(*end) || *end == '_'; end++)
+			;
+	}
+	*len = end - *name;
+	if (!braced)
+		return (end);
+
+	return ((*len == 0 || *end != '}') ? NULL : end + 1);
+}
+
+/**
+ * put_param - appends the value of a parameter to the word being expanded
+ * @hsh: shell data
+ * @name: the parameter's name, or "((expression))"
+ * @len: length of the name
+ * @quoted: non-zero between double quotes
+ *
+ * Description: "$@" gives each positional parameter as a field of its own,
+ * what comes before it joins the first one and what comes after it the last
+ * one. "$*" joins them with spaces, and so does "$@" in the patterns of a
+ * case.
+ *
+ * Return: the number of values appended, -1 on errors
+ */
+static int put_param(shell_t *hsh, const char *name, size_t len, int quoted)
+{
+	expand_t *x = &hsh->expand;
+	size_t i, argc = (hsh->call != NULL) ? hsh->call->argc : 1;
+	const char *value;
+	intmax_t number;
+	char num[32];
+
+	if (*name == '(' && arith_eval(hsh, name + 2, len - 4, &number) == -1)
+		return (-1);
+	if (*name == '(')
+		_imtoa(number, num);
+	if (*name != '@' && *name != '*')
+	{
+		value = (*name == '(') ? num : get_param(hsh, name, len, num);
+		if (value == NULL)
+			return (0);
+		return ((put_text(x, value, _strlen(value), quoted) == -1) ? -1 : 1);
+	}
+	for (i = 1; i < argc; i++)
+	{
+		if (i > 1 && *name == '@' && x->pattern != EXPAND_PATTERN)
+		{
+			if (end_field(x) == -1)
+				return (-1);
+		}
+		else if (i > 1 && put_text(x, " ", 1, quoted) == -1)
+			return (-1);
+		x->keep |= quoted;
+		value = hsh->call->args[i];
+		if (put_text(x, value, _strlen(value), quoted) == -1)
+			return (-1);
+	}
+
+	return (argc - 1);
+}
+
+/**
+ * expand_word - expands the parameters of a word and removes its quotes
+ * @hsh: shell data
+ * @word: the word, as it was written
+ * @pattern: what to build: EXPAND_FIELDS, EXPAND_GLOB for fields in which
+ *           what is quoted is escaped, to match as it is, or EXPAND_PATTERN
+ *           for a pattern of a case, escaped the same and a single field
+ *
+ * Description: The word is read once. Runs of ordinary bytes are found with
+ * find_meta() and copied at once, values are copied from where they live,
+ * all to a buffer kept from word to word. The fields are left one after the
+ * other in the buffer, each NUL-terminated. Values are not split: unless
+ * it is "$@", a parameter gives a single field. "$((expression))" gives the
+ * value of the expression.
+ *
+ * Return: the number of fields, -1 on errors
+ */
+int expand_word(shell_t *hsh, const char *word, int pattern)
+{
+	expand_t *x = &hsh->expand;
+	const char *p = word, *next, *name = NULL;
+	int set = META_WORD, q = 0, none = 0, n = 0;
+	size_t len = 0;
+
+	x->len = x->start = x->done = 0;
+	x->keep = 0;
+	x->pattern = pattern;
+	for (next = find_meta(p, set); *next != '\0'; next = find_meta(p, set))
+	{
+		if (put_text(x, p, next - p, q) == -1)
+			return (-1);
+		p = next;
+		if ((q && *p == '"') || (set != META_DQUOTE && isquote(*p)))
+		{
+			/* "$@" without parameters gives no field, even quoted */
+			x->keep |= (q && !none);
+			q = !q;
+			none = 0;
+			set = (!q) ? META_WORD : (*p == '"') ? META_DQUOTE : META_SQUOTE;
+			p++;
+			continue;
+		}
+		if (*p == '\\' && p[1] != '\0' &&
+			(!q || _strchr("$`\"\\\n", p[1]) != NULL))
+		{
+			if (p[1] != '\n' && put_text(x, p + 1, 1, 1) == -1)
+				return (-1);
+			p += 2;
+			continue;
+		}
+		next = (*p != '$') ? p + 1 : (p[1] != '(' || p[2] != '(')
+			? scan_param(p + 1, &name, &len) : skip_arith(p + 1);
+		if (*p == '$' && p[1] == '(' && p[2] == '(' && next != NULL)
+		{
+			name = p + 1;
+			len = next - name;
+		}
+		if (next == NULL)
+		{
+			fprintf(stderr, "%s: %lu: Bad substitution\n", hsh->prog_name,
+					hsh->cmd_count);
+			hsh->exit_code = 2;
+			return (-1);
+		}
+		if (*p != '$' || len == 0)
+			n = put_text(x, p, 1, q);
+		else
+		{
+			n = put_param(hsh, name, len, q);
+			none |= (n == 0 && *name == '@');
+		}
+		if (n == -1)
+			return (-1);
+		p = next;
+	}
+	if (put_text(x, p, next - p, q) == -1 || end_field(x) == -1)
+		return (-1);
+
+	return (x->done);
+}
@@ -0,0 +1,156 @@
+#include "shell.h"
+
+/**
+ * get_param - finds the value of a parameter
+ * @hsh: shell data
+ * @name: the parameter's name, not NUL-terminated
+ * @len: length of the name
+ * @num: a buffer of 32 bytes, for the values that are numbers
+ *
+ * Description: Numbered parameters are the arguments of the running
+ * function, "$0" is the shell's name and "$$" its process ID, even in a
+ * pipeline's children. Names are looked up in the environment.
+ *
+ * Return: the value, NULL if the parameter is not set
+ */
+const char *get_param(shell_t *hsh, const char *name, size_t len, char *num)
+{
+	size_t n = 0, argc = (hsh->call != NULL) ? hsh->call->argc : 1;
+
+	if (*name == '?' || *name == '$' || *name == '#')
+	{
+		_itoa((*name == '?') ? (size_t)hsh->exit_code :
+			  (*name == '$') ? (size_t)hsh->pid : argc - 1, num);
+		return (num);
+	}
+	if (!isdigit(*name))
+		return (find_env(&hsh->env, name, len));
+
+	/* past the number of arguments, the rest of the digits do not matter */
+	for (; len > 0 && n < argc; len--)
+		n = n * 10 + (*name++ - '0');
+	if (n == 0)
+		return (hsh->prog_name);
+
+	return ((n < argc) ? hsh->call->args[n] : NULL);
+}
+
+/**
+ * push_fields - adds fields to the arguments being built
+ * @x: the expansion buffers
+ * @fields: the fields, one after the other, each NUL-terminated
+ * @n: number of fields
+ *
+ * Return: 0 on success, -1 if memory ran out
+ */
+int push_fields(expand_t *x, char *fields, size_t n)
+{
+	size_t size = x->fields_size ? x->fields_size * 2 : 16;
+	char **grown;
+
+	while (x->n_fields + n > x->fields_size)
+	{
+		grown = _realloc(x->fields, x->n_fields * sizeof(char *),
+						 size * sizeof(char *));
+		if (grown == NULL)
+		{
+			fprintf(stderr, "Not enough system memory to continue\n");
+			return (-1);
+		}
+		x->fields = grown;
+		x->fields_size = size;
+		size *= 2;
+	}
+	for (; n > 0; n--)
+	{
+		x->fields[x->n_fields++] = fields;
+		if (n > 1)
+			fields += _strlen(fields) + 1;
+	}
+
+	return (0);
+}
+
+/**
+ * expand_args - builds the arguments of a command, expanding its words
+ * @hsh: shell data
+ * @prog: the program
+ * @in: the OP_EXPAND instruction
+ *
+ * Description: The fields of each word flagged WORD_RAW are copied to the
+ * arena at once, then globbed one by one if it is flagged WORD_GLOB; the
+ * other words are used from the program. Nothing but the array is
+ * allocated for them.
+ *
+ * Return: the arguments, in the arena, NULL on errors
+ */
+char **expand_args(shell_t *hsh, const program_t *prog, const insn_t *in)
+{
+	expand_t *x = &hsh->expand;
+	char **argv, *fields, *next;
+	uint32_t word;
+	int32_t i;
+	int n;
+
+	x->dirs = NULL; /* the listings of the previous command are gone */
+	for (x->n_fields = 0, i = 0; i < in->b; i++)
+	{
+		word = prog->words[in->a + i];
+		fields = prog->strings + WORD_OFFSET(word);
+		n = 1;
+		if (word & WORD_RAW)
+		{
+			n = expand_word(hsh, fields, (word & WORD_GLOB) ? EXPAND_GLOB :
+							EXPAND_FIELDS);
+			fields = (n > 0) ? arena_alloc(&hsh->arena, x->len) : NULL;
+			if (n == -1 || (n > 0 && fields == NULL))
+				return (NULL);
+			if (n > 0)
+				_memcpy(fields, x->buf, x->len);
+		}
+		if (!(word & WORD_GLOB) && push_fields(x, fields, n) == -1)
+			return (NULL);
+		for (; (word & WORD_GLOB) && n > 0; n--, fields = next)
+		{
+			next = fields + _strlen(fields) + 1;
+			if (glob_field(hsh, fields) == -1)
+				return (NULL);
+		}
+	}
+
+	argv = arena_alloc(&hsh->arena, (x->n_fields + 1) * sizeof(char *));
+	if (argv == NULL)
+		return (NULL);
+	_memcpy(argv, x->fields, x->n_fields * sizeof(char *));
+	argv[x->n_fields] = NULL;
+
+	return (argv);
+}
+
+/**
+ * expand_pattern - expands a pattern of a case
+ * @hsh: shell data
+ * @word: the pattern, as it was written
+ *
+ * Return: the pattern, valid until the next expansion, NULL on errors
+ */
+const char *expand_pattern(shell_t *hsh, const char *word)
+{
+	if (expand_word(hsh, word, EXPAND_PATTERN) == -1)
+		return (NULL);
+
+	return ((hsh->expand.done > 0) ? hsh->expand.buf : "");
+}
+
+/**
+ * free_expand - releases the expansion buffers
+ * @x: the expansion buffers
+ */
+void free_expand(expand_t *x)
+{
+	safe_free(x->buf);
+	safe_free(x->fields);
+	safe_free(x->path);
+	x->len = x->size = x->n_fields = x->fields_size = x->path_size = 0;
+	x->dirs = NULL;
+}
@@ -0,0 +1,140 @@
+#include "shell.h"
+
+/**
+ * define_function - defines a function, or replaces its previous definition
+ * @hsh: contains all the data relevant to the shell's operation
+ * @name: the function's name
+ * @prog: the program holding the function's body
+ * @start: the body's first instruction
+ *
+ * Description: The body is not copied, the function keeps a reference to
+ * the program it was compiled in.
+ *
+ * Return: 0 on success, -1 if memory ran out
+ */
+int define_function(shell_t *hsh, const char *name, program_t *prog,
+					size_t start)
+{
+	command_t *cmd = add_command(&hsh->commands, name);
+
+	if (cmd == NULL)
+	{
+		fprintf(stderr, "Not enough system memory to continue\n");
+		return (-1);
+	}
+
+	prog->refs++;
+	if (cmd->prog != NULL)
+		release_program(hsh, cmd->prog);
+	else
+		hsh->commands.n_functions++;
+	cmd->prog = prog;
+	cmd->start = start;
+
+	return (0);
+}
+
+/**
+ * new_program - allocates an empty program, kept alive by the shell
+ * @hsh: contains all the data relevant to the shell's operation
+ *
+ * Return: the program, NULL if memory ran out
+ */
+program_t *new_program(shell_t *hsh)
+{
+	program_t *prog = malloc(sizeof(program_t));
+
+	if (prog == NULL)
+	{
+		fprintf(stderr, "Not enough system memory to continue\n");
+		return (NULL);
+	}
+	memset(prog, 0, sizeof(program_t));
+	prog->next = hsh->programs;
+	hsh->programs = prog;
+
+	return (prog);
+}
+
+/**
+ * release_program - drops a reference to a program
+ * @hsh: contains all the data relevant to the shell's operation
+ * @prog: the program
+ *
+ * Description: A program is freed once no function refers to it and no
+ * call runs in it, unless it is the shell's current program.
+ */
+void release_program(shell_t *hsh, program_t *prog)
+{
+	program_t **link;
+
+	if (--prog->refs > 0 || prog == hsh->program)
+		return;
+
+	for (link = &hsh->programs; *link != NULL; link = &(*link)->next)
+	{
+		if (*link == prog)
+		{
+			*link = prog->next;
+			free_program(prog);
+			safe_free(prog);
+			return;
+		}
+	}
+}
+
+/**
+ * free_commands - releases the command table and all the programs
+ * @hsh: contains all the data relevant to the shell's operation
+ */
+void free_commands(shell_t *hsh)
+{
+	cmd_table_t *table = &hsh->commands;
+	program_t *next;
+
+	/* the names are interned, they go with the other interned names */
+	safe_free(table->slots);
+	table->size = table->count = table->n_functions = 0;
+
+	while (hsh->programs != NULL)
+	{
+		next = hsh->programs->next;
+		free_program(hsh->programs);
+		safe_free(hsh->programs);
+		hsh->programs = next;
+	}
+	hsh->program = NULL;
+}
+
+/**
+ * command_name - gives the interned name of a command of a program
+ * @prog: the program
+ * @in: the OP_ARGV or OP_EXPAND instruction building the command
+ *
+ * Description: The name is interned the first time the command runs and
+ * kept with the program, so that running it again, as in a loop, looks it
+ * up in the command table with a single probe and never hashes it.
+ *
+ * Return: the name, NULL if the first word is expanded or memory ran out
+ */
+const char *command_name(program_t *prog, const insn_t *in)
+{
+	uint32_t word;
+
+	if (in->b == 0)
+		return (NULL);
+	word = prog->words[in->a];
+	if (word & WORD_RAW)
+		return (NULL);
+	if (prog->names == NULL)
+	{
+		prog->names = malloc(prog->n_words * sizeof(char *));
+		if (prog->names == NULL)
+			return (NULL);
+		memset(prog->names, 0, prog->n_words * sizeof(char *));
+	}
+	if (prog->names[in->a] == NULL)
+		prog->names[in->a] = intern(prog->strings + WORD_OFFSET(word));
+
+	return (prog->names[in->a]);
+}
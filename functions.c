@@ -0,0 +1,191 @@
+#include "shell.h"
+
+/**
+ * save_local - saves a variable to restore when the function returns
+ * @hsh: contains all the data relevant to the shell's operation
+ * @call: the running call
+ * @name: the variable's name, not necessarily NUL-terminated
+ * @len: length of the name
+ *
+ * Return: the saved variable, NULL if memory ran out
+ */
+static saved_var_t *save_local(shell_t *hsh, call_frame_t *call,
+							   const char *name, size_t len)
+{
+	saved_var_t *var;
+	env_var_t *old;
+
+	for (var = call->locals; var != NULL; var = var->next)
+	{
+		if (!_strncmp(var->name, name, len) && var->name[len] == '\0')
+			return (var); /* already local, keep the old one */
+	}
+
+	var = malloc(sizeof(saved_var_t) + len + 1);
+	if (var == NULL)
+		return (NULL);
+	var->name = (char *)(var + 1);
+	_memcpy(var->name, name, len);
+	var->name[len] = '\0';
+	/* the table's own value, an assignment in front of the call is not it */
+	old = find_var(&hsh->env, name, len);
+	var->flags = (old != NULL) ? old->flags : -1;
+	if (old != NULL && (old->flags & VAR_UNSET))
+		old = NULL;
+	var->value = (old != NULL) ? _strdup(old->entry + len + 1) : NULL;
+	if (old != NULL && var->value == NULL)
+	{
+		safe_free(var);
+		return (NULL);
+	}
+	var->next = call->locals;
+	call->locals = var;
+
+	return (var);
+}
+
+/**
+ * restore_locals - gives the local variables of a call back their values
+ * and attributes
+ * @hsh: contains all the data relevant to the shell's operation
+ * @call: the call that returned
+ */
+static void restore_locals(shell_t *hsh, call_frame_t *call)
+{
+	saved_var_t *var;
+
+	while (call->locals != NULL)
+	{
+		var = call->locals;
+		call->locals = var->next;
+		restore_var(&hsh->env, var->name, var->value, var->flags);
+		safe_free(var->value);
+		safe_free(var);
+	}
+}
+
+/**
+ * call_function - runs a function with the arguments of the current command
+ * @hsh: contains all the data relevant to the shell's operation
+ * @cmd: the function
+ *
+ * Description: The body runs in this process, from the program it was
+ * compiled in, which is kept alive until the call returns. The arguments
+ * are copied to the arena, given back with the command, and become the
+ * positional parameters and the command being run is put aside
+ * while the body runs commands of its own.
+ *
+ * Return: the exit code of the function
+ */
+int call_function(shell_t *hsh, command_t *cmd)
+{
+	char **argv = hsh->sub_command;
+	program_t *prog = cmd->prog;
+	int subshell = hsh->subshell;
+	size_t base = hsh->env.base;
+	call_frame_t frame;
+
+	frame.depth = (hsh->call != NULL) ? hsh->call->depth + 1 : 1;
+	if (frame.depth > MAX_CALL_DEPTH)
+	{
+		fprintf(stderr, "%s: %lu: Maximum function recursion depth (%d) "
+				"reached\n", hsh->prog_name, hsh->cmd_count, MAX_CALL_DEPTH);
+		return (CMD_ERR);
+	}
+	frame.args = copy_items(&hsh->arena, argv);
+	if (frame.args == NULL)
+	{
+		fprintf(stderr, "Not enough system memory to continue\n");
+		return (1);
+	}
+	for (frame.argc = 0; frame.args[frame.argc] != NULL; frame.argc++)
+		;
+	frame.locals = NULL;
+	frame.prev = hsh->call;
+
+	hsh->call = &frame;
+	hsh->sub_command = NULL;
+	hsh->subshell = 0; /* the body's commands must not replace the shell */
+	hsh->env.base = hsh->env.n_overlay; /* the body sees the assignments */
+	prog->refs++;
+	vm_run(hsh, prog, cmd->start);
+	hsh->returning = 0;
+	release_program(hsh, prog);
+	restore_locals(hsh, &frame);
+	hsh->call = frame.prev;
+	hsh->sub_command = argv;
+	hsh->subshell = subshell;
+	hsh->env.base = base;
+
+	return (hsh->exit_code);
+}
+
+/**
+ * builtin_return - handles the builtin `return` command
+ * @hsh: contains all the data relevant to the shell's operation
+ *
+ * Description: The running function, or script at the top level, stops
+ * once the builtin is done.
+ *
+ * Return: the given exit code, else that of the last command
+ */
+int builtin_return(shell_t *hsh)
+{
+	const char *status = hsh->sub_command[1];
+
+	if (status != NULL && !isdigit(*status))
+	{
+		fprintf(stderr, "%s: %lu: return: Illegal number: %s\n",
+				hsh->prog_name, hsh->cmd_count, status);
+		return (CMD_ERR);
+	}
+	hsh->returning = 1;
+
+	return ((status != NULL) ? (_atoi(status) & 255) : hsh->exit_code);
+}
+
+/**
+ * builtin_local - handles the builtin `local` command
+ * @hsh: contains all the data relevant to the shell's operation
+ *
+ * Description: Each name[=value] argument makes the variable local to the
+ * running function: its value is restored when the function returns.
+ *
+ * Return: 0 on success, else an error code
+ */
+int builtin_local(shell_t *hsh)
+{
+	saved_var_t *var;
+	char **arg, *eq;
+	size_t len;
+	int status = 0;
+
+	if (hsh->call == NULL)
+	{
+		fprintf(stderr, "%s: %lu: local: not in a function\n", hsh->prog_name,
+				hsh->cmd_count);
+		return (CMD_ERR);
+	}
+	for (arg = hsh->sub_command + 1; *arg != NULL; arg++)
+	{
+		eq = _strchr(*arg, '=');
+		len = (eq != NULL) ? (size_t)(eq - *arg) : _strlen(*arg);
+		if (!is_name(*arg, len))
+		{
+			fprintf(stderr, "%s: %lu: local: %s: bad variable name\n",
+					hsh->prog_name, hsh->cmd_count, *arg);
+			status = CMD_ERR;
+			continue;
+		}
+		var = save_local(hsh, hsh->call, *arg, len);
+		if (var == NULL)
+		{
+			fprintf(stderr, "Not enough system memory to continue\n");
+			return (1);
+		}
+		if (eq != NULL && assign_var(hsh, var->name, len, eq + 1, 0) == -1)
+			status = CMD_ERR;
+	}
+
+	return (status);
+}
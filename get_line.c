@@ -23,24 +23,23 @@ ssize_t _getline(char **lineptr, size_t *n, int fd)
 			return (-1); /* memory allocation failed */
 	}
 	n_read = total_read = 0;
-	while ((n_read = read(fd, *lineptr + total_read, BUFF_SIZE)) > 0)
+	while (RUNNING)
 	{
-		total_read += n_read;
-		/* check if the buffer needs to be resized */
-		if (total_read >= buffer_size)
+		/* make sure a full read (and the null byte) always fits */
+		if (total_read + BUFF_SIZE > buffer_size)
 		{
-			buffer_size *= 2;
-			*lineptr = _realloc(*lineptr, total_read, buffer_size);
+			*lineptr = _realloc(*lineptr, total_read, buffer_size * 2 + 1);
 			if (*lineptr == NULL)
 				return (-1); /* resizing buffer memory failed */
-			*n = total_read;
-		}
-		if (total_read && (*lineptr)[total_read - 1] == '\n')
-		{
-			(*lineptr)[total_read] = '\0';
-			*n = total_read;
-			return (total_read);
+			buffer_size *= 2;
 		}
+		n_read = read(fd, *lineptr + total_read, BUFF_SIZE);
+		if (n_read <= 0)
+			break;
+		total_read += n_read;
+		/* a short read ending a line means the input is waiting on us */
+		if (n_read < BUFF_SIZE && (*lineptr)[total_read - 1] == '\n')
+			break;
 	}
 	if (n_read == -1)
 	{
@@ -49,6 +48,9 @@ ssize_t _getline(char **lineptr, size_t *n, int fd)
 	}
 	if (total_read == 0)
 		safe_free(*lineptr); /* nothing was read, free the memory */
+	else
+		(*lineptr)[total_read] = '\0';
+	*n = total_read;
 
 	return (total_read);
 }
@@ -0,0 +1,166 @@
+#include "shell.h"
+
+/**
+ * compare_names - orders two pathnames byte by byte, as qsort() wants
+ * @a: pointer to the first pathname
+ * @b: pointer to the second pathname
+ *
+ * Return: less than, equal to or greater than 0 as @a sorts before, with
+ * or after @b
+ */
+static int compare_names(const void *a, const void *b)
+{
+	const unsigned char *s1 = *(const unsigned char *const *)a;
+	const unsigned char *s2 = *(const unsigned char *const *)b;
+
+	while (*s1 != '\0' && *s1 == *s2)
+	{
+		s1++;
+		s2++;
+	}
+
+	return (*s1 - *s2);
+}
+
+/**
+ * has_glob - tells whether an expanded field is a pattern
+ * @field: the field, what was quoted in it is escaped
+ *
+ * Description: A '[' only counts when a ']' closes it in the same pathname
+ * component, so that "[" alone, as the test command, stays a word.
+ *
+ * Return: 1 if the field has an unescaped '*', '?' or bracket expression,
+ * 0 otherwise
+ */
+int has_glob(const char *field)
+{
+	const char *p;
+
+	for (; *field != '\0'; field++)
+	{
+		if (*field == '\\' && field[1] != '\0')
+			field++;
+		else if (*field == '*' || *field == '?')
+			return (1);
+		else if (*field == '[')
+		{
+			p = field + 1 + (field[1] == '!' || field[1] == '^');
+			for (p += (*p == ']'); *p != '\0' && *p != '/'; p++)
+			{
+				if (*p == ']')
+					return (1);
+			}
+		}
+	}
+
+	return (0);
+}
+
+/**
+ * unescape - removes the backslashes of a field that is not globbed
+ * @field: the field, rewritten in place
+ */
+static void unescape(char *field)
+{
+	char *w = field;
+
+	for (; *field != '\0'; field++)
+	{
+		if (*field == '\\' && field[1] != '\0')
+			field++;
+		*w++ = *field;
+	}
+	*w = '\0';
+}
+
+/**
+ * glob_path - adds the pathnames matching a pattern, one component at a time
+ * @hsh: shell data
+ * @pat: the components left, each matched against a directory's names
+ * @len: length of the path matched so far, in the path buffer
+ *
+ * Description: A component without wildcards is only appended, a single
+ * lstat() tells at the end whether the path exists. The others are matched
+ * against the listing of the directory, and names starting with '.' only
+ * match a component starting with '.'. A "**" component is left to
+ * glob_tree().
+ *
+ * Return: 0 on success, -1 if memory ran out
+ */
+int glob_path(shell_t *hsh, char *pat, size_t len)
+{
+	expand_t *x = &hsh->expand;
+	char *slash = _strchr(pat, '/'), *name;
+	int dot = (*pat == '.' || (*pat == '\\' && pat[1] == '.')), r = 0;
+	dir_list_t *dir = NULL;
+	size_t i, n = len;
+	struct stat st;
+
+	if (slash != NULL)
+		*slash = '\0';
+	if (pat[0] == '*' && pat[1] == '*' && pat[2] == '\0')
+	{
+		r = glob_tree(hsh, (slash != NULL) ? slash + 1 : NULL, len);
+		if (slash != NULL)
+			*slash = '/';
+		return (r);
+	}
+	if (has_glob(pat) && (dir = find_dir(hsh)) == NULL)
+		r = -1;
+	for (i = 0; r == 0 && (dir == NULL || i < dir->count); i++)
+	{
+		if (dir != NULL && ((dir->names[i][0] == '.' && !dot) ||
+							!glob_match(pat, dir->names[i])))
+			continue;
+		n = len;
+		r = path_append(x, &n, (dir != NULL) ? dir->names[i] : pat, !dir);
+		if (r == 0 && slash != NULL)
+			r = path_append(x, &n, "/", 0);
+		if (r == 0 && slash != NULL)
+			r = glob_path(hsh, slash + 1, n);
+		else if (r == 0 && (dir != NULL || lstat(x->path, &st) == 0))
+		{
+			name = arena_strdup(&hsh->arena, x->path);
+			r = (name == NULL) ? -1 : push_fields(x, name, 1);
+		}
+		if (dir == NULL)
+			break;
+	}
+	if (slash != NULL)
+		*slash = '/';
+	x->path[len] = '\0';
+
+	return (r);
+}
+
+/**
+ * glob_field - adds a field to the arguments, or the pathnames it matches
+ * @hsh: shell data
+ * @field: the field, in the arena, what was quoted in it escaped
+ *
+ * Description: The pathnames are sorted byte by byte, as other shells do
+ * in the C locale. A pattern matching nothing is kept, unescaped.
+ *
+ * Return: 0 on success, -1 if memory ran out
+ */
+int glob_field(shell_t *hsh, char *field)
+{
+	expand_t *x = &hsh->expand;
+	size_t first = x->n_fields, len = 0;
+
+	if (has_glob(field))
+	{
+		if (path_append(x, &len, "", 0) == -1 ||
+			glob_path(hsh, field, 0) == -1)
+			return (-1);
+		if (x->n_fields > first)
+		{
+			qsort(x->fields + first, x->n_fields - first, sizeof(char *),
+				  compare_names);
+			return (0);
+		}
+	}
+	unescape(field);
+
+	return (push_fields(x, field, 1));
+}
@@ -0,0 +1,126 @@
+#include "shell.h"
+
+/**
+ * path_append - appends a name to the path being globbed
+ * @x: the expansion buffers
+ * @len: length of the path, updated
+ * @name: the name
+ * @unescape: non-zero if the name is a pattern without wildcards, its
+ *            backslashes are then dropped
+ *
+ * Description: The path buffer grows by doubling and is kept from command
+ * to command. The path is left NUL-terminated.
+ *
+ * Return: 0 on success, -1 if memory ran out
+ */
+int path_append(expand_t *x, size_t *len, const char *name, int unescape)
+{
+	size_t need = *len + _strlen(name) + 2, size;
+	char *path;
+
+	if (need > x->path_size)
+	{
+		size = (need * 2 > PATH_SIZE) ? need * 2 : PATH_SIZE;
+		path = _realloc(x->path, x->path_size, size);
+		if (path == NULL)
+		{
+			fprintf(stderr, "Not enough system memory to continue\n");
+			return (-1);
+		}
+		x->path = path;
+		x->path_size = size;
+	}
+	for (; *name != '\0'; name++)
+	{
+		if (unescape && *name == '\\' && name[1] != '\0')
+			name++;
+		x->path[(*len)++] = *name;
+	}
+	x->path[*len] = '\0';
+
+	return (0);
+}
+
+/**
+ * list_dir - reads the names in a directory
+ * @hsh: shell data
+ * @path: the directory, "" for the current one
+ * @list: the listing to fill
+ *
+ * Description: The directory is read once, each name is copied to the
+ * arena. The names are pushed at the end of the command's fields while
+ * they are read, then moved to an array of their own.
+ *
+ * Return: 0 on success, even if the directory cannot be read, -1 if memory
+ * ran out
+ */
+static int list_dir(shell_t *hsh, const char *path, dir_list_t *list)
+{
+	expand_t *x = &hsh->expand;
+	size_t base = x->n_fields;
+	struct dirent *entry;
+	DIR *dir = opendir((*path != '\0') ? path : ".");
+	char *name;
+	int r = 0;
+
+	list->names = NULL;
+	list->count = 0;
+	if (dir == NULL)
+		return (0);
+	while (r == 0 && (entry = readdir(dir)) != NULL)
+	{
+		if (entry->d_name[0] == '.' && (entry->d_name[1] == '\0' ||
+			(entry->d_name[1] == '.' && entry->d_name[2] == '\0')))
+			continue;
+		name = arena_strdup(&hsh->arena, entry->d_name);
+		r = (name == NULL) ? -1 : push_fields(x, name, 1);
+	}
+	closedir(dir);
+	list->count = x->n_fields - base;
+	if (r == 0 && list->count > 0)
+	{
+		list->names = arena_alloc(&hsh->arena, list->count * sizeof(char *));
+		if (list->names == NULL)
+			r = -1;
+		else
+			_memcpy(list->names, x->fields + base,
+					list->count * sizeof(char *));
+	}
+	x->n_fields = base;
+
+	return (r);
+}
+
+/**
+ * find_dir - lists the directory in the path buffer, once per command
+ * @hsh: shell data
+ *
+ * Description: The listings live in the arena and are dropped with the
+ * command, so every pattern of a command against a directory, like the two
+ * of "*.c *.h", costs a single read of it, and the next command sees the
+ * files as they are then.
+ *
+ * Return: the listing, NULL if memory ran out
+ */
+dir_list_t *find_dir(shell_t *hsh)
+{
+	expand_t *x = &hsh->expand;
+	dir_list_t *list;
+
+	for (list = x->dirs; list != NULL; list = list->next)
+	{
+		if (!_strcmp(list->path, x->path))
+			return (list);
+	}
+
+	list = arena_alloc(&hsh->arena, sizeof(dir_list_t));
+	if (list == NULL)
+		return (NULL);
+	list->path = arena_strdup(&hsh->arena, x->path);
+	if (list->path == NULL || list_dir(hsh, list->path, list) == -1)
+		return (NULL);
+	list->next = x->dirs;
+	x->dirs = list;
+
+	return (list);
+}
@@ -0,0 +1,116 @@
+#include "shell.h"
+
+/**
+ * match_bracket - matches a character against a bracket expression
+ * @p: the expression, just past its '['
+ * @c: the character
+ * @end: where to store a pointer past the closing ']'
+ *
+ * Description: '!' or '^' first negates the expression, a ']' first is an
+ * ordinary character, and 'a-z' is a range.
+ *
+ * Return: 1 if the character matches, 0 if not, -1 if the expression is
+ * not closed: the '[' is then an ordinary character
+ */
+static int match_bracket(const char *p, unsigned char c, const char **end)
+{
+	int negate = (*p == '!' || *p == '^'), match = 0;
+	const char *first = p += negate;
+	unsigned char lo, hi;
+
+	while (*p != ']' || p == first)
+	{
+		if (*p == '\0')
+			return (-1);
+		if (*p == '\\' && p[1] != '\0')
+			p++;
+		lo = hi = *p;
+		if (p[1] == '-' && p[2] != ']' && p[2] != '\0')
+		{
+			p += 2;
+			if (*p == '\\' && p[1] != '\0')
+				p++;
+			hi = *p;
+		}
+		if (lo <= c && c <= hi)
+			match = 1;
+		p++;
+	}
+	*end = p + 1;
+
+	return (match != negate);
+}
+
+/**
+ * match_one - matches a character against the next element of a pattern
+ * @p: the pattern, moved past the element if it matches
+ * @c: the character
+ *
+ * Return: 1 if it matches, 0 otherwise
+ */
+static int match_one(const char **p, char c)
+{
+	const char *elem = *p, *end;
+	int match;
+
+	if (*elem == '?')
+	{
+		*p = elem + 1;
+		return (1);
+	}
+	if (*elem == '[')
+	{
+		match = match_bracket(elem + 1, c, &end);
+		if (match != -1)
+		{
+			*p = match ? end : elem;
+			return (match);
+		}
+	}
+	if (*elem == '\\' && elem[1] != '\0')
+		elem++;
+	if (*elem == '\0' || *elem != c)
+		return (0);
+	*p = elem + 1;
+
+	return (1);
+}
+
+/**
+ * glob_match - matches a string against a wildcard pattern
+ * @pattern: the pattern: '*', '?', bracket expressions, and backslash to
+ *           match the next character as it is
+ * @str: the string
+ *
+ * Description: No regex is involved. On a mismatch, the last '*' seen takes
+ * one more character and matching resumes after it, so the time taken is
+ * bounded by the product of the lengths.
+ *
+ * Return: 1 if the whole string matches, 0 otherwise
+ */
+int glob_match(const char *pattern, const char *str)
+{
+	const char *star = NULL, *resume = NULL;
+
+	while (*str != '\0')
+	{
+		if (*pattern == '*')
+		{
+			star = ++pattern;
+			resume = str;
+		}
+		else if (match_one(&pattern, *str))
+			str++;
+		else if (star == NULL)
+			return (0);
+		else
+		{
+			pattern = star;
+			str = ++resume;
+		}
+	}
+	while (*pattern == '*')
+		pattern++;
+
+	return (*pattern == '\0');
+}
@@ -0,0 +1,178 @@
+#include "shell.h"
+
+/**
+ * walk_start - opens the root of a walk and sets its workers up
+ * @w: the walk
+ * @root: the directory, "" for the current one
+ * @pattern: the pattern the names are matched against, NULL to list the
+ *           directories
+ *
+ * Description: There is a worker per processor, up to WALK_THREADS. The
+ * root is queued on the first one, the others steal from it.
+ *
+ * Return: 0 on success, 1 if the root cannot be read, -1 if memory ran out
+ */
+static int walk_start(walker_t *w, const char *root, const char *pattern)
+{
+	long n_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+	char **jobs, *dir;
+	size_t i;
+
+	memset(w, 0, sizeof(walker_t));
+	w->pattern = pattern;
+	w->dot = (pattern != NULL &&
+			  (*pattern == '.' || (*pattern == '\\' && pattern[1] == '.')));
+	w->n_workers = (n_cpus < 1) ? 1 : (n_cpus > WALK_THREADS) ? WALK_THREADS
+															  : (size_t)n_cpus;
+	w->root = open((*root != '\0') ? root : ".", O_RDONLY | O_DIRECTORY);
+	if (w->root == -1)
+		return (1);
+	w->workers = calloc(w->n_workers, sizeof(walk_worker_t));
+	jobs = malloc(sizeof(char *));
+	dir = malloc(1);
+	if (w->workers == NULL || jobs == NULL || dir == NULL)
+	{
+		fprintf(stderr, "Not enough system memory to continue\n");
+		safe_free(w->workers);
+		safe_free(jobs);
+		safe_free(dir);
+		close(w->root);
+		return (-1);
+	}
+	*dir = '\0';
+	jobs[0] = dir;
+	w->workers[0].jobs = jobs;
+	w->workers[0].tail = w->workers[0].size = 1;
+	w->pending = w->pushed = 1;
+	pthread_mutex_init(&w->lock, NULL);
+	pthread_cond_init(&w->wake, NULL);
+	for (i = 0; i < w->n_workers; i++)
+	{
+		w->workers[i].walker = w;
+		w->workers[i].id = i;
+		pthread_mutex_init(&w->workers[i].lock, NULL);
+	}
+
+	return (0);
+}
+
+/**
+ * walk_free - releases the workers of a walk and closes its root
+ * @w: the walk
+ */
+static void walk_free(walker_t *w)
+{
+	size_t i;
+
+	for (i = 0; i < w->n_workers; i++)
+	{
+		pthread_mutex_destroy(&w->workers[i].lock);
+		safe_free(w->workers[i].jobs);
+		safe_free(w->workers[i].out);
+	}
+	pthread_mutex_destroy(&w->lock);
+	pthread_cond_destroy(&w->wake);
+	safe_free(w->workers);
+	close(w->root);
+}
+
+/**
+ * walk_merge - adds the results of the workers to the pathnames
+ * @hsh: shell data
+ * @w: the walk, done
+ * @rest: the components after the "**", NULL if it was the last one
+ * @len: length of the path up to the "**", in the path buffer
+ *
+ * Description: The matches of the last component are added as they are.
+ * When components are left after that, the results are the directories,
+ * and the rest of the pattern is matched from each of them. glob_field()
+ * sorts the pathnames at the end.
+ *
+ * Return: 0 on success, -1 if memory ran out
+ */
+static int walk_merge(shell_t *hsh, walker_t *w, char *rest, size_t len)
+{
+	expand_t *x = &hsh->expand;
+	size_t i, off, n, end;
+	char *name, *out;
+	int r = 0;
+
+	/* the workers are joined, their flags can be read */
+	for (i = 0; i < w->n_workers; i++)
+		r |= w->workers[i].failed;
+	if (r)
+	{
+		fprintf(stderr, "Not enough system memory to continue\n");
+		return (-1);
+	}
+	for (i = 0; r == 0 && i < w->n_workers; i++)
+	{
+		out = w->workers[i].out;
+		for (off = 0; r == 0 && off < w->workers[i].out_len; off += n)
+		{
+			n = _strlen(out + off) + 1;
+			end = len;
+			r = path_append(x, &end, out + off, 0);
+			if (r == 0 && w->pattern == NULL)
+				r = glob_path(hsh, rest, end);
+			else if (r == 0)
+			{
+				name = arena_strdup(&hsh->arena, x->path);
+				r = (name == NULL) ? -1 : push_fields(x, name, 1);
+			}
+		}
+	}
+
+	return (r);
+}
+
+/**
+ * glob_tree - adds the pathnames a "**" component leads to
+ * @hsh: shell data
+ * @rest: the components after the "**", NULL if it was the last one
+ * @len: length of the path up to the "**", in the path buffer
+ *
+ * Description: A "**" stands for any number of directories, none included:
+ * the "*.c" following the "**" of "src/" is matched in "src/" itself and in
+ * every directory under it. The tree is read by several threads at once,
+ * each reading a directory at a time and matching the last component of
+ * the pattern as it goes, while the shell waits for them. Alone at the end,
+ * a "**" matches every name of the tree. Consecutive "**" are one.
+ *
+ * Return: 0 on success, -1 if memory ran out
+ */
+int glob_tree(shell_t *hsh, char *rest, size_t len)
+{
+	expand_t *x = &hsh->expand;
+	int collect, r = 0;
+	char end[1] = "";
+	walker_t w;
+	size_t i;
+
+	/* a "**" after a "**" would only find the same paths again */
+	while (rest != NULL && rest[0] == '*' && rest[1] == '*' &&
+		   (rest[2] == '\0' || rest[2] == '/'))
+		rest = (rest[2] == '/') ? rest + 3 : NULL;
+	collect = (rest != NULL && (*rest == '\0' || _strchr(rest, '/') != NULL));
+	if ((collect || (rest == NULL && len > 0)) &&
+		glob_path(hsh, collect ? rest : end, len) == -1)
+		return (-1);
+	x->path[len] = '\0';
+	r = walk_start(&w, x->path, collect ? NULL : (rest != NULL) ? rest : "*");
+	if (r != 0)
+		return ((r == -1) ? -1 : 0);
+	for (i = 1; i < w.n_workers; i++)
+		w.workers[i].started = !pthread_create(&w.workers[i].thread, NULL,
+											   walk_run, &w.workers[i]);
+	walk_run(&w.workers[0]);
+	for (i = 1; i < w.n_workers; i++)
+	{
+		if (w.workers[i].started)
+			pthread_join(w.workers[i].thread, NULL);
+	}
+	r = walk_merge(hsh, &w, rest, len);
+	walk_free(&w);
+	x->path[len] = '\0';
+
+	return (r);
+}
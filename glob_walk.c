@@ -0,0 +1,250 @@
+#include "shell.h"
+#include <sys/syscall.h>
+
+/**
+ * struct walk_dirent - An entry returned by getdents64(), as the kernel
+ * lays it out.
+ * @ino: Inode number.
+ * @off: Offset of the next entry.
+ * @reclen: Length of the entry, name and padding included.
+ * @type: Type of the file (DT_*), DT_UNKNOWN if the filesystem does not say.
+ * @name: The name, NUL-terminated.
+ */
+
+typedef struct walk_dirent
+{
+	uint64_t ino;
+	int64_t off;
+	unsigned short reclen;
+	unsigned char type;
+	char name[1];
+} walk_dirent_t;
+
+/**
+ * walk_out - adds a result of a worker
+ * @ww: the worker
+ * @dir: the directory the result is in, relative to the root of the walk
+ * @name: the name, NULL if the result is @dir itself
+ */
+static void walk_out(walk_worker_t *ww, const char *dir, const char *name)
+{
+	size_t dir_len = _strlen(dir), len = dir_len + 1, size;
+	char *out;
+
+	len += (name != NULL) ? _strlen(name) : 0;
+	if (ww->out_len + len > ww->out_size)
+	{
+		size = ww->out_size ? ww->out_size * 2 : WALK_OUT_MIN;
+		size = (size < ww->out_len + len) ? ww->out_len + len : size;
+		out = _realloc(ww->out, ww->out_len, size);
+		if (out == NULL)
+		{
+			ww->failed = 1;
+			return;
+		}
+		ww->out = out;
+		ww->out_size = size;
+	}
+	_memcpy(ww->out + ww->out_len, dir, dir_len);
+	if (name != NULL)
+		_memcpy(ww->out + ww->out_len + dir_len, name, len - dir_len - 1);
+	ww->out[ww->out_len + len - 1] = '\0';
+	ww->out_len += len;
+}
+
+/**
+ * walk_push - queues a directory on a worker's own queue
+ * @ww: the worker
+ * @path: the directory, allocated, the queue takes it
+ *
+ * Description: The directory counts as pending before the other workers
+ * can see it, so that the walk cannot look done while it is being stolen.
+ * The workers are woken once the whole parent directory is read.
+ */
+static void walk_push(walk_worker_t *ww, char *path)
+{
+	walker_t *w = ww->walker;
+	size_t size;
+	char **jobs;
+	int queued = 0;
+
+	pthread_mutex_lock(&w->lock);
+	w->pending++;
+	pthread_mutex_unlock(&w->lock);
+	pthread_mutex_lock(&ww->lock);
+	if (ww->tail == ww->size && ww->head > 0)
+	{
+		memmove(ww->jobs, ww->jobs + ww->head,
+				(ww->tail - ww->head) * sizeof(char *));
+		ww->tail -= ww->head;
+		ww->head = 0;
+	}
+	if (ww->tail == ww->size)
+	{
+		size = ww->size ? ww->size * 2 : WALK_QUEUE_MIN;
+		jobs = _realloc(ww->jobs, ww->size * sizeof(char *),
+						size * sizeof(char *));
+		if (jobs != NULL)
+		{
+			ww->jobs = jobs;
+			ww->size = size;
+		}
+	}
+	if (ww->tail < ww->size)
+	{
+		ww->jobs[ww->tail++] = path;
+		queued = 1;
+	}
+	pthread_mutex_unlock(&ww->lock);
+	if (!queued)
+	{
+		ww->failed = 1;
+		safe_free(path);
+		pthread_mutex_lock(&w->lock);
+		w->pending--;
+		pthread_mutex_unlock(&w->lock);
+	}
+}
+
+/**
+ * walk_take - takes a directory to read, waiting for one if need be
+ * @ww: the worker
+ *
+ * Description: A worker takes the newest directory of its own queue, the
+ * deepest one, whose parent it has just read. When its queue is empty it
+ * steals the oldest directory of another queue, the top of a subtree big
+ * enough to keep it busy for a while.
+ *
+ * Return: the directory, NULL once the walk is done
+ */
+static char *walk_take(walk_worker_t *ww)
+{
+	walker_t *w = ww->walker;
+	walk_worker_t *victim;
+	unsigned long seen;
+	char *path = NULL;
+	size_t i;
+
+	while (1)
+	{
+		pthread_mutex_lock(&w->lock);
+		seen = w->pushed;
+		pthread_mutex_unlock(&w->lock);
+		for (i = 0; path == NULL && i < w->n_workers; i++)
+		{
+			victim = &w->workers[(ww->id + i) % w->n_workers];
+			pthread_mutex_lock(&victim->lock);
+			if (victim->head < victim->tail)
+				path = (i == 0) ? victim->jobs[--victim->tail]
+								: victim->jobs[victim->head++];
+			pthread_mutex_unlock(&victim->lock);
+		}
+		if (path != NULL)
+			return (path);
+		pthread_mutex_lock(&w->lock);
+		if (w->pending == 0)
+		{
+			pthread_mutex_unlock(&w->lock);
+			return (NULL);
+		}
+		if (w->pushed == seen) /* else look again, something was queued */
+		{
+			w->idle++;
+			pthread_cond_wait(&w->wake, &w->lock);
+			w->idle--;
+		}
+		pthread_mutex_unlock(&w->lock);
+	}
+}
+
+/**
+ * walk_dir - reads a directory, matches its names and queues its
+ * subdirectories
+ * @ww: the worker
+ * @dir: the directory, relative to the root of the walk
+ *
+ * Description: The directory is opened relative to the root's descriptor
+ * and read with getdents64(), whose entries tell the type of each file on
+ * most filesystems, the others cost an fstatat() per name. Hidden
+ * directories and symbolic links are not walked into, as other shells do.
+ *
+ * Return: the number of subdirectories queued
+ */
+static size_t walk_dir(walk_worker_t *ww, const char *dir)
+{
+	walker_t *w = ww->walker;
+	int fd = openat(w->root, (*dir != '\0') ? dir : ".",
+					O_RDONLY | O_DIRECTORY | O_NOFOLLOW);
+	size_t dir_len = _strlen(dir), n_len, queued = 0;
+	char buf[WALK_BUF], *path;
+	walk_dirent_t *entry;
+	struct stat st;
+	long n, off;
+	int type;
+
+	while (fd != -1 && (n = syscall(SYS_getdents64, fd, buf, sizeof(buf))) > 0)
+	{
+		for (off = 0; off < n; off += entry->reclen)
+		{
+			entry = (walk_dirent_t *)(buf + off);
+			type = entry->type;
+			if (entry->name[0] == '.' && (entry->name[1] == '\0' ||
+				(entry->name[1] == '.' && entry->name[2] == '\0')))
+				continue;
+			if (type == DT_UNKNOWN)
+				type = (!fstatat(fd, entry->name, &st, AT_SYMLINK_NOFOLLOW) &&
+						S_ISDIR(st.st_mode)) ? DT_DIR : DT_REG;
+			if (w->pattern != NULL && (entry->name[0] != '.' || w->dot) &&
+				glob_match(w->pattern, entry->name))
+				walk_out(ww, dir, entry->name);
+			if (type != DT_DIR || entry->name[0] == '.')
+				continue;
+			n_len = _strlen(entry->name);
+			path = malloc(dir_len + n_len + 2);
+			if (path == NULL)
+			{
+				ww->failed = 1;
+				continue;
+			}
+			_memcpy(path, dir, dir_len);
+			_memcpy(path + dir_len, entry->name, n_len);
+			path[dir_len + n_len] = '/';
+			path[dir_len + n_len + 1] = '\0';
+			if (w->pattern == NULL)
+				walk_out(ww, path, NULL);
+			walk_push(ww, path);
+			queued++;
+		}
+	}
+	if (fd != -1)
+		close(fd);
+
+	return (queued);
+}
+
+/**
+ * walk_run - runs a worker of the walker until every directory is read
+ * @arg: the worker
+ *
+ * Return: NULL, as pthread_create() wants
+ */
+void *walk_run(void *arg)
+{
+	walk_worker_t *ww = arg;
+	walker_t *w = ww->walker;
+	size_t queued;
+	char *dir;
+
+	while ((dir = walk_take(ww)) != NULL)
+	{
+		queued = walk_dir(ww, dir);
+		safe_free(dir);
+		pthread_mutex_lock(&w->lock);
+		w->pushed += queued;
+		if (--w->pending == 0 || (queued > 0 && w->idle > 0))
+			pthread_cond_broadcast(&w->wake);
+		pthread_mutex_unlock(&w->lock);
+	}
+
+	return (NULL);
+}
@@ -0,0 +1,33 @@
+#include "shell.h"
+
+/**
+ * hash_text - hashes a text (FNV-1a)
+ * @text: the text, not necessarily NUL-terminated
+ * @len: length of the text
+ *
+ * Description: The one hash of the shell: names, expressions, paths.
+ * Compiled programs store tables built with it, the script cache version
+ * must be bumped if it changes.
+ *
+ * Return: the hash
+ */
+unsigned long hash_text(const char *text, size_t len)
+{
+	unsigned long hash = 14695981039346656037UL;
+
+	for (; len > 0; len--, text++)
+		hash = (hash ^ (unsigned char)*text) * 1099511628211UL;
+
+	return (hash);
+}
+
+/**
+ * hash_name - hashes a name
+ * @name: the name
+ *
+ * Return: the hash, the same as hash_text() gives for it
+ */
+unsigned long hash_name(const char *name)
+{
+	return (hash_text(name, _strlen(name)));
+}
@@ -5,19 +5,30 @@
  * @str: The string to split
  * @delim: the delimeter to split on
  *
+ * Description: The delimiters are looked up in a table, so each character
+ * of @str is classified once per pass: one pass counts the words, the
+ * other copies them.
+ *
  * Return: a pointer to an array of strings (words) on success, NULL otherwise.
  */
 char **_strtok(const char *str, const char *delim)
 {
 	char **str_array;
-	int word_count, word_start, word_end; /* keeps track of words */
-	int len, index, i;
-	char *tmp_delim = (char *)delim;
+	unsigned char is_delim[256] = {0};
+	int word_count, index = 0;
+	const char *start;
 
+	if (str == NULL)
+		return (NULL);
 	if (delim == NULL)
-		tmp_delim = " \t\n"; /* assume spaces, tabs and newline */
-
-	word_count = get_word_count(str, tmp_delim);
+		delim = " \t\n"; /* assume spaces, tabs and newline */
+	while (*delim)
+		is_delim[(unsigned char)*delim++] = 1;
+	is_delim[0] = 1; /* the end of the string ends the last word */
+
+	for (word_count = 0, start = str; *start; start++)
+		word_count += (!is_delim[(unsigned char)*start] &&
+					   is_delim[(unsigned char)start[1]]);
 	if (word_count == 0)
 		return (NULL); /* no valid words */
 
@@ -25,26 +36,17 @@ char **_strtok(const char *str, const char *delim)
 	if (str_array == NULL)
 		return (NULL); /* memory allocation failed */
 
-	word_start = index = 0;
-	len = _strlen(str);
-
-	for (i = 0; i < len; i++)
+	for (start = str; *str; str++)
 	{
-		if ((!_strchr(tmp_delim, str[i]) && _strchr(tmp_delim, str[i + 1])) ||
-			(!_strchr(tmp_delim, str[i]) && str[i + 1] == '\0'))
+		if (is_delim[(unsigned char)*str])
+			start = str + 1; /* still between words */
+		else if (is_delim[(unsigned char)str[1]])
 		{
-			word_end = i + 1;
-			str_array[index] = new_word(str, word_start, word_end);
-
+			str_array[index] = new_word(start, 0, str + 1 - start);
 			/* memory allocation for new word failed, clean up and leave */
-			if (str_array[index] == NULL)
+			if (str_array[index++] == NULL)
 				return (free_str(&str_array), NULL);
-			index++;
 		}
-		else if (!_strchr(tmp_delim, str[i]) && !_strchr(tmp_delim, str[i + 1]))
-			continue; /* still in a word, keep counting */
-		else
-			word_start = i + 1;
 	}
 	/* terminate the array */
 	str_array[index] = NULL;
@@ -154,29 +156,22 @@ char *_strrchr(const char *s, int c)
  */
 int get_word_count(const char *str, const char *delim)
 {
-	int in_word = 0; /* flag to track if we are in a word or not */
+	unsigned char is_delim[256] = {0};
 	int word_count = 0;
-	char *tmp_delim = (char *)delim;
 
 	if (str == NULL || *str == '\0')
 		return (0);
 
 	if (delim == NULL)
-		tmp_delim = " \t";
-
-	while (*str)
-	{
-		if (_strchr(tmp_delim, *str))
-		{
-			in_word = 0; /* not in a word, reset flag */
-		}
-		else if (!in_word)
-		{
-			in_word = 1;  /* found the start of a new word */
-			word_count++; /* count word */
-		}
-		str++;
-	}
+		delim = " \t";
+	while (*delim)
+		is_delim[(unsigned char)*delim++] = 1;
+	is_delim[0] = 1; /* the end of the string ends the last word */
+
+	/* count the last character of every word */
+	for (; *str; str++)
+		word_count += (!is_delim[(unsigned char)*str] &&
+					   is_delim[(unsigned char)str[1]]);
 
 	return (word_count);
 }
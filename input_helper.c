@@ -1,5 +1,8 @@
 #include "shell.h"
 
+/* the shell whose prompt is shown again on Ctrl+C */
+static shell_t *signal_shell;
+
 /**
  * init_shell - initializes shell data
  *
@@ -9,7 +12,14 @@ shell_t *init_shell(void)
 {
 	shell_t *hsh = malloc(sizeof(shell_t));
 
-	if (hsh == NULL)
+	if (hsh != NULL)
+	{
+		memset(&hsh->commands, 0, sizeof(cmd_table_t));
+		memset(&hsh->env, 0, sizeof(env_t));
+	}
+	/* the builtins are registered first, functions are added as defined */
+	if (hsh == NULL || init_commands(&hsh->commands) == -1 ||
+		init_env(&hsh->env, environ) == -1)
 	{
 		fprintf(stderr, "Launching shell failed.\n"
 				"Please ensure you have enough system resources for this operation\n");
@@ -17,92 +27,39 @@ shell_t *init_shell(void)
 	}
 
 	hsh->path_list = NULL;
-	hsh->aliases = NULL;
+	memset(&hsh->aliases, 0, sizeof(alias_table_t));
 	hsh->line = NULL;
 	hsh->sub_command = NULL;
-	hsh->commands = NULL;
-	hsh->tokens = NULL;
-	hsh->token = NULL;
+	hsh->cmd_name = NULL;
+	hsh->lexer.tokens = NULL;
+	hsh->lexer.count = hsh->lexer.size = 0;
+	hsh->lexer.error = NULL;
+	memset(&hsh->expand, 0, sizeof(expand_t));
+	memset(&hsh->arith, 0, sizeof(arith_cache_t));
+	hsh->arena.chunks = hsh->arena.current = NULL;
+	hsh->loops.frames = NULL;
+	hsh->loops.count = hsh->loops.size = 0;
+	hsh->parser.chunks = NULL;
+	reset_parser(&hsh->parser);
+	hsh->program = hsh->programs = NULL;
+	hsh->call = NULL;
+	hsh->returning = 0;
+	hsh->subshell = 0;
+	hsh->repl = 0;
+	/* asked once, the input stays where it is for the shell's life */
+	hsh->interactive = isatty(STDIN_FILENO);
+	hsh->pid = getpid();
+	memset(&hsh->prompt, 0, sizeof(prompt_t));
+	hsh->cache.path = NULL;
+	hsh->cache.map = NULL;
+	hsh->snapshot.map = NULL;
 	hsh->cmd_count = 0;
 	hsh->exit_code = 0;
+	signal_shell = hsh;
 
 	return (hsh);
 }
 
-/**
- * get_hostname - returns the hostname of the system using the '/ect/hostname'
- * file
- * @buffer: the buffer to write the hostname to, it should large enough.
- *
- * Return: the hostname if found, else defaults to using 'hsh' when anything
- * goes wrong
- */
-char *get_hostname(char *buffer)
-{
-	int fd, n_read;
-
-	fd = open("/etc/hostname", O_RDONLY);
-
-	/* let's check whether the file opening failed */
-	if (fd == -1)
-	{
-		/* looks like it did, fall back to using 'hsh' as the hostname */
-		_strcpy(buffer, "hsh");
-		return (buffer);
-	}
-
-	/* file opening was successful, let's grab the hostname */
-	n_read = read(fd, buffer, 100);
-
-	/* one more time, let's check for read failures and fall back as needed */
-	if (n_read == -1 || n_read == 0)
-		_strcpy(buffer, "hsh");
-	else
-		buffer[n_read - 1] = '\0'; /* hostname was succesfully grabbed, use it */
-
-	close(fd);
-
-	return (buffer);
-}
-/**
- * show_prompt - shows the prompt in interactive mode
- */
-void show_prompt(void)
-{
-	char prompt[PROMPT_SIZE], hostname[100];
-	char *username = _getenv("USER"), *pwd;
-
-	if (username != NULL)
-	{
-		pwd = _getenv("PWD");
-		if (pwd != NULL)
-		{
-			/* get the right directory name to show on the prompt */
-			pwd = (*pwd == '/' && *(pwd + 1) == '\0')
-					  ? pwd
-					  : (_strrchr(pwd, '/') +
-						 1); /* show only the current directory */
-
-			sprintf(prompt, "[%s@%s %s]%% ", username, get_hostname(hostname),
-					(!_strcmp(pwd, username))
-						? "~" /* show '~' for the user's $HOME directory */
-						: pwd);
-		}
-	}
-	else
-	{
-		/*
-		 * there was not enough environment variables to build a much more
-		 * customized prompt, fall back to the minimal prompt
-		 */
-		sprintf(prompt, "hsh%% ");
-	}
-
-	/* show the prompt in interactive modes only */
-	if (isatty(STDIN_FILENO))
-		printf("%s", prompt);
-}
-
 /**
  * sigint_handler - handles signal interrupts (Ctrl+C)
  * @signum: signal number (unused)
@@ -110,6 +67,7 @@ void show_prompt(void)
 void sigint_handler(__attribute__((unused))int signum)
 {
 	putchar('\n');
-	show_prompt();
+	if (signal_shell != NULL)
+		show_prompt(signal_shell);
 	fflush(stdout);
 }
@@ -0,0 +1,109 @@
+#include "shell.h"
+
+/* every distinct name the shell keeps, stored once */
+static intern_table_t names;
+
+/**
+ * name_slot - finds the slot of a name in the intern table
+ * @name: the name
+ * @hash: the name's hash
+ *
+ * Return: the slot holding the name, or the free slot it would go in
+ */
+static interned_t *name_slot(const char *name, unsigned long hash)
+{
+	size_t i = hash & (names.size - 1);
+
+	while (names.slots[i].name != NULL &&
+		   (names.slots[i].hash != hash || _strcmp(names.slots[i].name, name)))
+		i = (i + 1) & (names.size - 1);
+
+	return (&names.slots[i]);
+}
+
+/**
+ * grow_names - doubles the number of slots of the intern table
+ *
+ * Return: 0 on success, -1 if memory ran out
+ */
+static int grow_names(void)
+{
+	interned_t *old = names.slots;
+	size_t i, old_size = names.size;
+
+	names.size = old_size ? old_size * 2 : INTERN_MIN;
+	names.slots = malloc(names.size * sizeof(interned_t));
+	if (names.slots == NULL)
+	{
+		names.slots = old;
+		names.size = old_size;
+		return (-1);
+	}
+	memset(names.slots, 0, names.size * sizeof(interned_t));
+
+	for (i = 0; i < old_size; i++)
+	{
+		if (old[i].name != NULL)
+			*name_slot(old[i].name, old[i].hash) = old[i];
+	}
+	safe_free(old);
+
+	return (0);
+}
+
+/**
+ * intern - gives the single copy of a name the shell keeps
+ * @name: the name
+ *
+ * Description: Names of commands and aliases are interned, so that tables
+ * keyed by them compare pointers instead of strings. The copies live until
+ * free_interned() is called.
+ *
+ * Return: the copy, the same for equal names, NULL if memory ran out
+ */
+const char *intern(const char *name)
+{
+	unsigned long hash = hash_name(name);
+	interned_t *slot;
+
+	if ((names.count + 1) * 4 > names.size * 3 && grow_names() == -1)
+		return (NULL);
+	slot = name_slot(name, hash);
+	if (slot->name != NULL)
+		return (slot->name);
+
+	slot->name = arena_strdup(&names.strings, name);
+	if (slot->name == NULL)
+		return (NULL);
+	slot->hash = hash;
+	names.count++;
+
+	return (slot->name);
+}
+
+/**
+ * find_interned - looks a name up without interning it
+ * @name: the name
+ *
+ * Description: A name that was never interned is no command or alias, so a
+ * single probe answers most lookups of external commands.
+ *
+ * Return: the interned copy, NULL if the name was never interned
+ */
+const char *find_interned(const char *name)
+{
+	if (names.count == 0)
+		return (NULL);
+
+	return (name_slot(name, hash_name(name))->name);
+}
+
+/**
+ * free_interned - releases the interned names, they must no longer be used
+ */
+void free_interned(void)
+{
+	safe_free(names.slots);
+	free_arena(&names.strings);
+	names.size = names.count = 0;
+}
@@ -0,0 +1,222 @@
+#include "shell.h"
+
+/**
+ * push_token - appends a token to the lexer's token array
+ * @lx: the lexer
+ * @type: the kind of token
+ * @start: where the token starts in the line
+ * @len: length of the token
+ * @flags: what a word token needs before use
+ *
+ * Return: 0 on success, -1 if growing the token array failed
+ */
+static int push_token(lexer_t *lx, int type, char *start, size_t len,
+					  int flags)
+{
+	token_t *tok;
+
+	if (lx->count == lx->size)
+	{
+		tok = _realloc(lx->tokens, lx->size * sizeof(token_t),
+					   (lx->size ? lx->size * 2 : 64) * sizeof(token_t));
+		if (tok == NULL)
+			return (-1);
+		lx->tokens = tok;
+		lx->size = lx->size ? lx->size * 2 : 64;
+	}
+
+	tok = &lx->tokens[lx->count++];
+	tok->type = type;
+	tok->flags = flags;
+	tok->start = start;
+	tok->len = len;
+
+	return (0);
+}
+
+/**
+ * scan_quoted - skips over a quoted part of a word
+ * @p: points at the opening quote
+ * @flags: the word's flags, updated with what was found inside the quotes
+ *
+ * Description: Nothing is special between single quotes. Between double
+ * quotes a backslash escapes the next character and '$' still expands.
+ * Other bytes are skipped without being looked at one by one.
+ *
+ * Return: a pointer past the closing quote, NULL if there is none
+ */
+static char *scan_quoted(char *p, int *flags)
+{
+	char quote = *p++;
+	int set = (quote == '"') ? META_DQUOTE : META_SQUOTE;
+
+	*flags |= W_QUOTED;
+	for (p = find_meta(p, set); *p != quote; p = find_meta(p, set))
+	{
+		if (*p == '\0')
+			return (NULL);
+		if (quote == '"' && *p == '\\' && p[1] != '\0')
+			p++;
+		else if (quote == '"' && *p == '$')
+			*flags |= W_DOLLAR;
+		p++;
+	}
+
+	return (p + 1);
+}
+
+/**
+ * scan_word - finds the end of the word starting at @p
+ * @lx: the lexer
+ * @p: start of the word
+ *
+ * Description: Only the bytes find_meta() stops at can end the word or
+ * need a flag, the bytes in between are skipped in blocks.
+ *
+ * Return: a pointer past the word, NULL on errors (lx->error is set)
+ */
+static char *scan_word(lexer_t *lx, char *p)
+{
+	char *start = p;
+	int flags = 0;
+
+	for (p = find_meta(p, META_WORD); !isword_end(p);
+		 p = find_meta(p, META_WORD))
+	{
+		if (isquote(*p))
+		{
+			p = scan_quoted(p, &flags);
+			if (p == NULL)
+			{
+				lx->error = "Unterminated quoted string";
+				return (NULL);
+			}
+			continue;
+		}
+		if (*p == '$' && p[1] == '(' && p[2] == '(')
+		{
+			flags |= W_DOLLAR;
+			p = skip_arith(p + 1);
+			if (p == NULL)
+			{
+				lx->error = "Missing '))'";
+				return (NULL);
+			}
+			continue;
+		}
+		if (*p == '\\')
+		{
+			flags |= W_ESCAPED;
+			p += (p[1] != '\0');
+		}
+		else if (*p == '$')
+		{
+			flags |= W_DOLLAR;
+			p += (p[1] == '{'); /* "${name}" is no brace group */
+		}
+		else if (*p == '*' || *p == '?' || *p == '[')
+			flags |= W_GLOB;
+		else if (*p == '{' && !isword_end(p + 1))
+			flags |= W_BRACE;
+		p++;
+	}
+
+	if (push_token(lx, TOK_WORD, start, p - start, flags) == -1)
+		return (NULL);
+
+	return (p);
+}
+
+/**
+ * scan_operator - adds the operator starting at @p
+ * @lx: the lexer
+ * @p: start of the operator
+ *
+ * Description: "((" starts an arithmetic command, its token is the
+ * expression, up to the matching "))".
+ *
+ * Return: a pointer past the operator, NULL on errors (lx->error is set for
+ * syntax errors)
+ */
+static char *scan_operator(lexer_t *lx, char *p)
+{
+	int type = TOK_NEWLINE;
+	size_t len = 1;
+	char *end;
+
+	if (*p == '(' && p[1] == '(')
+	{
+		end = skip_arith(p);
+		if (end == NULL)
+		{
+			lx->error = "Missing '))'";
+			return (NULL);
+		}
+		if (push_token(lx, TOK_ARITH, p + 2, (end - 2) - (p + 2), 0) == -1)
+			return (NULL);
+		return (end);
+	}
+	if (*p == ';' && p[1] == ';')
+	{
+		type = TOK_DSEMI;
+		len = 2;
+	}
+	else if (*p == ';')
+		type = TOK_SEMI;
+	else if (*p == '(' || *p == ')')
+		type = (*p == '(') ? TOK_LPAREN : TOK_RPAREN;
+	else if (*p == '|' && p[1] != '|')
+		type = TOK_PIPE;
+	else if (*p == '&' || *p == '|')
+	{
+		type = (*p == '&') ? TOK_AND_IF : TOK_OR_IF;
+		len = 2;
+	}
+
+	if (push_token(lx, type, p, len, 0) == -1)
+		return (NULL);
+
+	return (p + len);
+}
+
+/**
+ * lex_line - splits a line into tokens in a single pass
+ * @lx: the lexer, its token array is reused from line to line
+ * @line: the line to scan
+ *
+ * Description: Tokens are spans into @line, nothing is copied. Blanks and
+ * comments are dropped, quotes and escapes are kept in the word and only
+ * flagged, so that token_word() knows which words have to be rewritten.
+ * On a syntax error the tokens found before it are kept, followed by the
+ * end of input token.
+ *
+ * Return: 0 on success, -1 on errors (lx->error is set for syntax errors)
+ */
+int lex_line(lexer_t *lx, char *line)
+{
+	char *p = line, *next;
+
+	lx->count = 0;
+	lx->error = NULL;
+	while (*p != '\0')
+	{
+		if (isblank(*p) || (*p == '\\' && p[1] == '\n'))
+			next = p + ((*p == '\\') ? 2 : 1);
+		else if (*p == '#') /* comments run up to the end of the line */
+			next = find_meta(p, META_LINE);
+		else if (isoperator(p))
+			next = scan_operator(lx, p);
+		else
+			next = scan_word(lx, p);
+		if (next == NULL && lx->error == NULL)
+			return (-1);
+		if (next == NULL)
+			break;
+		p = next;
+	}
+
+	if (push_token(lx, TOK_EOF, p, 0, 0) == -1)
+		return (-1);
+
+	return ((lx->error != NULL) ? -1 : 0);
+}
@@ -0,0 +1,97 @@
+#include "shell.h"
+
+/**
+ * unquote_word - removes quotes and escapes from a word, in place
+ * @word: the word
+ * @len: length of the word
+ *
+ * Description: The result is never longer than the word itself, so it is
+ * written over the word as it is read. A backslash-newline pair is a line
+ * continuation and disappears completely.
+ *
+ * Return: the new length of the word
+ */
+size_t unquote_word(char *word, size_t len)
+{
+	size_t r = 0, w = 0;
+	char quote = '\0';
+
+	while (r < len)
+	{
+		if (quote == '\0' && isquote(word[r]))
+			quote = word[r++];
+		else if (quote != '\0' && word[r] == quote)
+		{
+			quote = '\0';
+			r++;
+		}
+		else if (word[r] == '\\' && quote != '\'' && r + 1 < len &&
+				 (quote == '\0' || _strchr("$`\"\\\n", word[r + 1])))
+		{
+			if (word[r + 1] != '\n')
+				word[w++] = word[r + 1];
+			r += 2;
+		}
+		else
+			word[w++] = word[r++];
+	}
+	word[w] = '\0';
+
+	return (w);
+}
+
+/**
+ * token_word - turns a word token into a string usable as an argument
+ * @tok: the word token
+ *
+ * Description: Words are terminated in place, so this must only be called
+ * once the whole line has been lexed. Only words flagged with quotes or
+ * escapes are rewritten, all other words are used straight from the line.
+ *
+ * Return: the word
+ */
+char *token_word(token_t *tok)
+{
+	tok->start[tok->len] = '\0';
+	if (tok->flags & (W_QUOTED | W_ESCAPED))
+	{
+		tok->len = unquote_word(tok->start, tok->len);
+		tok->flags &= ~(W_QUOTED | W_ESCAPED);
+	}
+
+	return (tok->start);
+}
+
+/**
+ * free_lexer - releases the token array of a lexer
+ * @lx: the lexer
+ */
+void free_lexer(lexer_t *lx)
+{
+	safe_free(lx->tokens);
+	lx->count = lx->size = 0;
+}
+
+/**
+ * skip_arith - finds the end of an arithmetic expression
+ * @p: the first of its two opening parentheses
+ *
+ * Description: The parentheses of the expression must be balanced, the one
+ * closing the first pair must be followed by the final ')'.
+ *
+ * Return: a pointer past the closing "))", NULL if there is none
+ */
+char *skip_arith(const char *p)
+{
+	int depth = 0;
+
+	for (; *p != '\0'; p++)
+	{
+		if (*p == '(')
+			depth++;
+		else if (*p == ')' && --depth == 1)
+			return ((p[1] == ')') ? (char *)p + 2 : NULL);
+	}
+
+	return (NULL);
+}
@@ -5,161 +5,144 @@
  * over to the executor only after it has confirmed the command is valid
  * @hsh: contains all the data relevant to the shell's operation
  *
+ * Description: The line is scanned once by the lexer, parsed once into a
+ * syntax tree and compiled to bytecode, which is then executed. The program
+ * is reused for the next line, unless functions were defined in it. A script
+ * whose cache entry is open is saved to the cache first, unless it has
+ * syntax errors.
+ *
  * Return: the exit code of the executed program, else -1 if something goes
- * wrong
+ * wrong, or INCOMPLETE if the input read from the standard input stops in
+ * the middle of a command
  */
 int parse_line(shell_t *hsh)
 {
-	size_t i;
-
-	/* skip normal ENTER keys and leading comments */
-	if (*hsh->line == '\n' || *hsh->line == '#')
-		return (0);
+	node_t *tree;
 
-	/* first of all, let's get rid of all comments */
-	hsh->line = handle_comments(hsh->line);
-
-	hsh->tokens = _strtok(hsh->line, "\n");
-	if (hsh->tokens == NULL)
+	if (lex_line(&hsh->lexer, hsh->line) == -1 && hsh->lexer.error == NULL)
 	{
 		fprintf(stderr, "Not enough system memory to continue\n");
 		return (-1);
 	}
 
-	for (i = 0; hsh->tokens[i] != NULL; i++)
+	tree = parse_program(&hsh->parser, hsh->lexer.tokens,
+						 hsh->lexer.error == NULL);
+	if (hsh->repl && hsh->parser.bad != NULL &&
+		hsh->parser.bad->type == TOK_EOF)
+		return (INCOMPLETE); /* nothing runs until the command is complete */
+	if (hsh->program == NULL || hsh->program->refs > 0)
+		hsh->program = new_program(hsh); /* the functions keep the old one */
+	if (tree == NULL || hsh->program == NULL ||
+		compile_program(hsh->program, tree) == -1)
+		return (-1);
+	if (hsh->cache.path != NULL && hsh->parser.bad == NULL)
+		save_script_cache(hsh, hsh->program);
+
+	vm_run(hsh, hsh->program, 0);
+	hsh->returning = 0;
+	if (hsh->parser.bad != NULL)
 	{
-		hsh->token = hsh->tokens[i];
-
-		if (!_strcmp(hsh->tokens[i], "exit") && hsh->tokens[i + 1] == NULL)
-		{
-			handle_exit(hsh, multi_free);
-		}
-
-		/* now let's tokenize all the commands provided by the user */
-		hsh->commands = _strtok(hsh->token, ";\n");
-		if (hsh->commands == NULL)
-		{
-			fprintf(stderr, "Memory allocation failed...\n");
-			return (-1);
-		}
-
-		hsh->exit_code = parse(hsh);
-		free_str(&hsh->commands);
+		print_syntax_error(hsh);
+		hsh->exit_code = CMD_ERR;
 	}
 
-	free_str(&hsh->tokens);
 	return (hsh->exit_code);
 }
 
 /**
- * parse - parses an array of commands received from the prompt
+ * use_alias - expands the alias the current command starts with, if any
  * @hsh: contains all the data relevant to the shell's operation
  *
- * Return: the exit code of the executed program
+ * Return: 1 if the command is done: it expanded to nothing, or to a value
+ * with operators that was run as a line, 0 if it is still to run
  */
-int parse(shell_t *hsh)
+static int use_alias(shell_t *hsh)
 {
-	ssize_t i, offset;
-	char *cur_cmd = NULL, *operator = NULL;
-	char *next_cmd = NULL, *temp_next_cmd = NULL;
+	alias_t *alias = find_alias(&hsh->aliases, hsh->sub_command[0]);
 
-	for (i = 0; hsh->commands[i] != NULL; i++)
+	if (alias == NULL)
+		return (0);
+	if (expand_alias(hsh, alias) == -1)
 	{
-		operator = get_operator(hsh->commands[i]);
-		if (operator != NULL)
-		{
-			offset = strcspn(hsh->commands[i], operator);
-			/* extract the command before the operator */
-			cur_cmd = strndup(hsh->commands[i], offset);
-			if (cur_cmd == NULL)
-				return (0);
-			hsh->sub_command = _strtok(cur_cmd, NULL);
-			safe_free(cur_cmd);
-			if (hsh->sub_command == NULL)
-				return (0);
-			hsh->sub_command = handle_variables(hsh);
-			parse_helper(hsh, i);
-
-			temp_next_cmd = _strdup(&hsh->commands[i][offset + 2]);
-			safe_free(next_cmd);
-			safe_free(hsh->commands[i]);
-
-			/* check the exit code and react accordingly */
-			if ((!_strcmp(operator, "&&") && hsh->exit_code == 0) ||
-				(!_strcmp(operator, "||") && hsh->exit_code != 0))
-			{
-				hsh->commands[i] = temp_next_cmd;
-				parse(hsh);
-				next_cmd = temp_next_cmd;
-			}
-			else
-				safe_free(temp_next_cmd);
-		}
-		else
-			parse_and_execute(hsh, i);
+		hsh->exit_code = 1;
+		return (1);
 	}
-	return (hsh->exit_code);
+	if (hsh->sub_command[0] == NULL)
+		return (1); /* the alias expanded to nothing */
+	/* the alias at the end of the chain may be one with operators */
+	alias = find_alias(&hsh->aliases, hsh->sub_command[0]);
+	if (alias == NULL || !alias->compound || alias->running)
+		return (0);
+	hsh->exit_code = run_alias(hsh, alias);
+
+	return (1);
 }
 
 /**
- * parse_and_execute - parses each sub command line and executes it
+ * resolve_command - looks the command being run up, with its alias
  * @hsh: contains all the data relevant to the shell's operation
- * @index: the current index in commands array
  *
- * Return: the exit code of the executed program
+ * Description: A name interned when its command first ran takes a single
+ * probe of the command table. Whether an alias has the name too is kept
+ * in the command and only looked up again once the aliases have changed,
+ * so a builtin or a function costs the same lookup whatever the aliases.
+ *
+ * Return: the builtin or function, NULL if there is none of that name
  */
-int parse_and_execute(shell_t *hsh, size_t index)
+command_t *resolve_command(shell_t *hsh)
 {
-	/* get the sub commands and work on them */
-	hsh->sub_command = _strtok(hsh->commands[index], NULL);
-	if (hsh->sub_command == NULL)
+	command_t *cmd;
+
+	cmd = (hsh->cmd_name != NULL) ?
+		lookup_command(&hsh->commands, hsh->cmd_name) :
+		find_command(&hsh->commands, hsh->sub_command[0]);
+	if (cmd != NULL && cmd->alias_gen != hsh->aliases.gen)
 	{
-		return (0); /* probably just lots of tabs or spaces, maybe both */
+		cmd->alias = (find_alias(&hsh->aliases, cmd->name) != NULL);
+		cmd->alias_gen = hsh->aliases.gen;
 	}
 
-	/* check for variables */
-	hsh->sub_command = handle_variables(hsh);
-	if (hsh->sub_command[0] != NULL && hsh->sub_command != NULL)
-		parse_helper(hsh, index);
-	else
-		free_str(&hsh->sub_command);
-
-	/* cleanup and leave */
-	safe_free(hsh->commands[index]);
-	return (hsh->exit_code);
+	return (cmd);
 }
 
 /**
  * parse_helper - performs extra parsing on behalf of the parse and execute
  * function
  * @hsh: contains all the data relevant to the shell's operation
- * @index: the current index in commands array
+ * @alias_cmd: the text of the command if it is an alias builtin, else NULL
  */
-void parse_helper(shell_t *hsh, size_t index)
+void parse_helper(shell_t *hsh, char *alias_cmd)
 {
-	char *alias_value;
+	command_t *cmd;
+	char *name;
 
-	if (!_strcmp(hsh->sub_command[0], "alias") ||
-			!_strcmp(hsh->sub_command[0], "unalias"))
+	if (alias_cmd != NULL)
 	{
-		hsh->exit_code = handle_alias(&hsh->aliases, hsh->commands[index]);
-		free_str(&hsh->sub_command);
+		hsh->exit_code = handle_alias(&hsh->aliases, alias_cmd);
 		return;
 	}
 
-	alias_value = get_alias(hsh->aliases, hsh->sub_command[0]);
-	if (alias_value != NULL)
+	/* functions and builtins are found with a single lookup */
+	cmd = resolve_command(hsh);
+	if (cmd == NULL || cmd->alias)
 	{
-		build_alias_cmd(&hsh->sub_command, alias_value);
-		safe_free(alias_value);
+		name = hsh->sub_command[0];
+		if (use_alias(hsh))
+			return;
+		if (hsh->sub_command[0] != name) /* the alias was expanded */
+			cmd = find_command(&hsh->commands, hsh->sub_command[0]);
 	}
-
-	hsh->exit_code = handle_builtin(hsh);
-	if (hsh->exit_code != NOT_BUILTIN)
+	if (cmd != NULL && cmd->prog != NULL)
 	{
-		free_str(&hsh->sub_command);
-		return; /* shell builtin executed well */
+		hsh->exit_code = call_function(hsh, cmd);
+		return;
 	}
+	if (cmd != NULL && cmd->builtin != -1)
+	{
+		hsh->exit_code = run_builtin(hsh, cmd->builtin);
+		return;
+	}
+
 	/* handle the command with the PATH variable */
 	if (hsh->path_list != NULL && !_strchr(hsh->sub_command[0], '/'))
 	{
@@ -175,7 +158,6 @@ void parse_helper(shell_t *hsh, size_t index)
 		else
 			hsh->exit_code = print_cmd_not_found(hsh);
 	}
-	free_str(&hsh->sub_command);
 }
 
 /**
@@ -1,5 +1,45 @@
 #include "shell.h"
 
+/**
+ * read_more - reads the next line of a command that goes on over several
+ * lines, and runs the command once it is complete
+ * @hsh: contains all the data relevant to the shell's operation
+ *
+ * Return: the exit code of the command, INCOMPLETE if it still goes on
+ */
+static int read_more(shell_t *hsh)
+{
+	char *more = NULL, *line;
+	size_t len = 0, line_len = _strlen(hsh->line);
+	ssize_t n_read;
+	int status;
+
+	if (hsh->interactive)
+	{
+		printf("> ");
+		fflush(stdout);
+	}
+	n_read = _getline(&more, &len, STDIN_FILENO);
+	++hsh->cmd_count;
+
+	line = (n_read > 0) ? malloc(line_len + n_read + 1) : NULL;
+	if (line == NULL)
+	{
+		/* end of input, or no memory: report the incomplete command */
+		safe_free(more);
+		hsh->repl = 0;
+		status = parse_line(hsh);
+		hsh->repl = 1;
+		return (status);
+	}
+	_memcpy(line, hsh->line, line_len);
+	_memcpy(line + line_len, more, n_read + 1);
+	multi_free("ss", hsh->line, more);
+	hsh->line = line;
+
+	return (parse_line(hsh));
+}
+
 /**
  * main - the entry point for the shell
  * @argc: command line arguments counter
@@ -12,22 +52,39 @@ int main(int argc, char *argv[])
 	size_t len = 0;
 	ssize_t n_read = 0;
 	shell_t *hsh = NULL;
+	int status;
 
 	/* scout for singal interrupts (Ctrl + C) */
 	signal(SIGINT, sigint_handler);
 
 	hsh = init_shell();
 	hsh->prog_name = argv[0];
-	build_path(&hsh->path_list);
+	build_path(&hsh->env, &hsh->path_list);
 
+	/* -S FILE starts from a snapshot instead of the startup file */
+	if (argc >= 3 && !_strcmp(argv[1], "-S"))
+	{
+		if (load_snapshot(hsh, argv[2]) == -1)
+		{
+			fprintf(stderr, "%s: 0: Can't load snapshot %s\n",
+					hsh->prog_name, argv[2]);
+			hsh->exit_code = CMD_ERR;
+			handle_exit(hsh, multi_free);
+		}
+		argc -= 2;
+		argv += 2;
+	}
+	else if (argc < 2 && hsh->interactive)
+		load_rc(hsh);
 	if (argc >= 2)
 	{
 		handle_file_as_input(argv[1], hsh);
 	}
 
+	hsh->repl = 1;
 	while (RUNNING)
 	{
-		show_prompt();
+		show_prompt(hsh);
 		fflush(stdout);
 
 		n_read = _getline(&hsh->line, &len, STDIN_FILENO);
@@ -37,13 +94,20 @@ int main(int argc, char *argv[])
 		/* check for empty prompt or if Ctrl+D was received */
 		if (n_read == 0)
 		{
-			if (isatty(STDIN_FILENO))
+			if (hsh->interactive)
 				printf("exit\n");
 			handle_exit(hsh, multi_free); /* clean up and leave */
 		}
 
-		hsh->exit_code = parse_line(hsh);
-		safe_free(hsh->line);
+		status = parse_line(hsh);
+		if (status == INCOMPLETE)
+		{
+			while (status == INCOMPLETE)
+				status = read_more(hsh);
+			/* only the buffers of _getline() can be read into again */
+			safe_free(hsh->line);
+		}
+		hsh->exit_code = status;
 	}
 
 	return (hsh->exit_code);
@@ -19,6 +19,23 @@ void _itoa(size_t n, char *s)
 	_reverse(s, i);
 }
 
+/**
+ * _imtoa - convert signed integer to string
+ *
+ * @n: the integer to convert
+ * @s: a char array to hold the conversion, at least 22 bytes
+ */
+void _imtoa(intmax_t n, char *s)
+{
+	if (n < 0)
+	{
+		*s++ = '-';
+		_itoa((size_t)(0 - (uintmax_t)n), s); /* INTMAX_MIN has no opposite */
+	}
+	else
+		_itoa((size_t)n, s);
+}
+
 /**
  * _reverse - reverse string in place
  *
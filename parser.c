@@ -0,0 +1,163 @@
+#include "shell.h"
+
+/**
+ * parse_command - parses a simple or a compound command, or a function
+ * definition
+ * @p: the parser
+ *
+ * Description: The words of a simple command are consecutive tokens, so the
+ * node just points at the first one. An arithmetic command is its single
+ * token.
+ *
+ * Return: the command node, NULL on errors
+ */
+static node_t *parse_command(parser_t *p)
+{
+	int word = reserved_word(p->tok);
+	node_t *cmd;
+
+	if (starts_compound(word))
+		return (parse_compound(p, word));
+	if (word == R_NONE && p->tok->type == TOK_WORD &&
+		p->tok[1].type == TOK_LPAREN)
+		return (parse_function(p));
+	if (p->tok->type == TOK_ARITH)
+	{
+		cmd = new_node(p, N_ARITH);
+		if (cmd != NULL)
+		{
+			cmd->words = p->tok++;
+			cmd->n_words = 1;
+		}
+		return (cmd);
+	}
+	if (p->tok->type != TOK_WORD || word != R_NONE)
+	{
+		p->bad = p->tok;
+		return (NULL);
+	}
+
+	cmd = new_node(p, N_COMMAND);
+	if (cmd == NULL)
+		return (NULL);
+	cmd->words = p->tok;
+	while (p->tok->type == TOK_WORD)
+		p->tok++;
+	cmd->n_words = p->tok - cmd->words;
+
+	return (cmd);
+}
+
+/**
+ * parse_pipeline - parses commands joined by '|', optionally negated by '!'
+ * @p: the parser
+ *
+ * Return: the pipeline node, NULL on errors
+ */
+static node_t *parse_pipeline(parser_t *p)
+{
+	node_t *pipeline = new_node(p, N_PIPELINE), *cmd;
+
+	if (pipeline == NULL)
+		return (NULL);
+	if (p->tok->type == TOK_WORD && p->tok->len == 1 &&
+		*p->tok->start == '!' && p->tok->flags == 0)
+	{
+		pipeline->flags |= NF_BANG;
+		p->tok++;
+	}
+
+	cmd = pipeline->child[0] = parse_command(p);
+	while (cmd != NULL && p->tok->type == TOK_PIPE)
+	{
+		p->tok++;
+		skip_newlines(p);
+		cmd->next = parse_command(p);
+		cmd = cmd->next;
+	}
+
+	return ((cmd != NULL) ? pipeline : NULL);
+}
+
+/**
+ * parse_and_or - parses pipelines joined by '&&' and '||'
+ * @p: the parser
+ *
+ * Description: The chain is parsed in a loop and its pipelines are linked
+ * one after the other, so a chain of any length takes constant stack space.
+ * Each pipeline records the operator that follows it.
+ *
+ * Return: the and-or node, NULL on errors
+ */
+node_t *parse_and_or(parser_t *p)
+{
+	node_t *and_or = new_node(p, N_AND_OR), *pipeline;
+
+	if (and_or == NULL)
+		return (NULL);
+
+	pipeline = and_or->child[0] = parse_pipeline(p);
+	while (pipeline != NULL &&
+		   (p->tok->type == TOK_AND_IF || p->tok->type == TOK_OR_IF))
+	{
+		pipeline->flags |= (p->tok->type == TOK_AND_IF) ? NF_AND : NF_OR;
+		p->tok++;
+		skip_newlines(p);
+		pipeline->next = parse_pipeline(p);
+		pipeline = pipeline->next;
+	}
+
+	return ((pipeline != NULL) ? and_or : NULL);
+}
+
+/**
+ * parse_program - builds the syntax tree of a whole input
+ * @p: the parser, its nodes from the previous input are reused
+ * @tokens: the tokens of the input
+ * @complete: zero if the lexer stopped early on a syntax error
+ *
+ * Description: The input is parsed once, in full, before anything runs.
+ * When a syntax error is found, the lines before the one holding the error
+ * are kept so that they still run, like they would in other shells.
+ *
+ * Return: the list of and-or lists of the input, NULL if memory ran out.
+ * p->bad points at the offending token if there was a syntax error.
+ */
+node_t *parse_program(parser_t *p, token_t *tokens, int complete)
+{
+	node_t *list, *and_or, *tail = NULL, *last_line = NULL;
+
+	reset_parser(p);
+	p->tok = tokens;
+	list = new_node(p, N_LIST);
+	skip_newlines(p);
+	while (list != NULL && p->tok->type != TOK_EOF)
+	{
+		and_or = parse_and_or(p);
+		if (and_or == NULL)
+			break;
+		if (tail == NULL)
+			list->child[0] = and_or;
+		else
+			tail->next = and_or;
+		tail = and_or;
+		if (p->tok->type == TOK_SEMI)
+			p->tok++;
+		else if (p->tok->type != TOK_NEWLINE && p->tok->type != TOK_EOF)
+			p->bad = p->tok;
+		if (skip_newlines(p))
+			last_line = tail; /* every command up to here is complete */
+		if (p->bad != NULL)
+			break;
+	}
+	if (list == NULL || (p->bad == NULL && p->tok->type != TOK_EOF))
+		return (NULL); /* memory ran out */
+	if (p->bad == NULL && !complete)
+		p->bad = p->tok;
+	if (p->bad != NULL && last_line == NULL)
+		list->child[0] = NULL;
+	else if (p->bad != NULL)
+		last_line->next = NULL;
+
+	return (list);
+}
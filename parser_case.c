@@ -0,0 +1,101 @@
+#include "shell.h"
+
+/**
+ * parse_arm - parses an arm of a case command, pattern|...) list ;;
+ * @p: the parser, at the arm's first pattern or its optional '('
+ *
+ * Description: The patterns are kept in place, every other token from the
+ * first one, with the '|' tokens in between.
+ *
+ * Return: the arm node, NULL on errors
+ */
+static node_t *parse_arm(parser_t *p)
+{
+	node_t *arm = new_node(p, N_ARM);
+
+	if (arm == NULL)
+		return (NULL);
+	if (p->tok->type == TOK_LPAREN)
+		p->tok++;
+	arm->words = p->tok;
+	for (;;)
+	{
+		if (p->tok->type != TOK_WORD)
+		{
+			p->bad = p->tok;
+			return (NULL);
+		}
+		p->tok++;
+		arm->n_words++;
+		if (p->tok->type != TOK_PIPE)
+			break;
+		p->tok++;
+	}
+	if (p->tok->type != TOK_RPAREN)
+	{
+		p->bad = p->tok;
+		return (NULL);
+	}
+	p->tok++;
+
+	skip_newlines(p);
+	if (p->tok->type != TOK_DSEMI && reserved_word(p->tok) != R_ESAC)
+	{
+		arm->child[0] = parse_compound_list(p);
+		if (arm->child[0] == NULL)
+			return (NULL);
+	}
+	if (p->tok->type == TOK_DSEMI)
+		p->tok++;
+	else if (reserved_word(p->tok) != R_ESAC)
+	{
+		p->bad = p->tok;
+		return (NULL);
+	}
+	skip_newlines(p);
+
+	return (arm);
+}
+
+/**
+ * parse_case - parses a case command
+ * @p: the parser, at the 'case'
+ *
+ * Description: The ';;' ending the last arm can be left out.
+ *
+ * Return: the case node, NULL on errors
+ */
+node_t *parse_case(parser_t *p)
+{
+	node_t *node = new_node(p, N_CASE), *arm, *tail = NULL;
+
+	p->tok++;
+	if (node == NULL)
+		return (NULL);
+	if (p->tok->type != TOK_WORD)
+	{
+		p->bad = p->tok;
+		return (NULL);
+	}
+	node->words = p->tok++;
+	node->n_words = 1;
+	skip_newlines(p);
+	if (!accept_word(p, R_IN))
+		return (NULL);
+
+	skip_newlines(p);
+	while (reserved_word(p->tok) != R_ESAC)
+	{
+		arm = parse_arm(p);
+		if (arm == NULL)
+			return (NULL);
+		if (tail == NULL)
+			node->child[0] = arm;
+		else
+			tail->next = arm;
+		tail = arm;
+	}
+	p->tok++;
+
+	return (node);
+}
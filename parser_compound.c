@@ -0,0 +1,183 @@
+#include "shell.h"
+
+/**
+ * parse_compound_list - parses the list of commands inside a compound
+ * command, up to the reserved word that ends it
+ * @p: the parser
+ *
+ * Return: the list node, NULL on errors or if the list is empty
+ */
+node_t *parse_compound_list(parser_t *p)
+{
+	node_t *list = new_node(p, N_LIST), *and_or, *tail = NULL;
+	int word;
+
+	if (list == NULL)
+		return (NULL);
+	skip_newlines(p);
+	while (p->tok->type == TOK_WORD || p->tok->type == TOK_ARITH)
+	{
+		word = reserved_word(p->tok);
+		if (word != R_NONE && !starts_compound(word))
+			break; /* the word closing the list */
+		and_or = parse_and_or(p);
+		if (and_or == NULL)
+			return (NULL);
+		if (tail == NULL)
+			list->child[0] = and_or;
+		else
+			tail->next = and_or;
+		tail = and_or;
+		if (p->tok->type == TOK_SEMI)
+			p->tok++;
+		else if (p->tok->type != TOK_NEWLINE)
+			break;
+		skip_newlines(p);
+	}
+	if (list->child[0] == NULL)
+	{
+		p->bad = p->tok;
+		return (NULL);
+	}
+
+	return (list);
+}
+
+/**
+ * parse_if - parses an if command, or the elif part of one
+ * @p: the parser, at the 'if' or 'elif'
+ *
+ * Description: An elif part is parsed as an if command nested in the else
+ * part, it takes the closing 'fi' with it.
+ *
+ * Return: the if node, NULL on errors
+ */
+static node_t *parse_if(parser_t *p)
+{
+	node_t *node = new_node(p, N_IF);
+
+	p->tok++;
+	if (node == NULL)
+		return (NULL);
+	node->child[0] = parse_compound_list(p);
+	if (node->child[0] == NULL || !accept_word(p, R_THEN))
+		return (NULL);
+	node->child[1] = parse_compound_list(p);
+	if (node->child[1] == NULL)
+		return (NULL);
+
+	if (reserved_word(p->tok) == R_ELIF)
+	{
+		node->child[2] = parse_if(p);
+		return ((node->child[2] != NULL) ? node : NULL);
+	}
+	if (reserved_word(p->tok) == R_ELSE)
+	{
+		p->tok++;
+		node->child[2] = parse_compound_list(p);
+		if (node->child[2] == NULL)
+			return (NULL);
+	}
+
+	return (accept_word(p, R_FI) ? node : NULL);
+}
+
+/**
+ * parse_loop - parses a while or until command
+ * @p: the parser, at the 'while' or 'until'
+ *
+ * Return: the loop node, NULL on errors
+ */
+static node_t *parse_loop(parser_t *p)
+{
+	node_t *node = new_node(p, N_WHILE);
+
+	if (node == NULL)
+		return (NULL);
+	if (reserved_word(p->tok) == R_UNTIL)
+		node->flags |= NF_UNTIL;
+	p->tok++;
+
+	node->child[0] = parse_compound_list(p);
+	if (node->child[0] == NULL || !accept_word(p, R_DO))
+		return (NULL);
+	node->child[1] = parse_compound_list(p);
+	if (node->child[1] == NULL || !accept_word(p, R_DONE))
+		return (NULL);
+
+	return (node);
+}
+
+/**
+ * parse_for - parses a for command
+ * @p: the parser, at the 'for'
+ *
+ * Description: The words after 'in' are kept as a simple command, so that
+ * they are expanded the same way.
+ *
+ * Return: the for node, NULL on errors
+ */
+static node_t *parse_for(parser_t *p)
+{
+	node_t *node = new_node(p, N_FOR), *items;
+
+	p->tok++;
+	if (node == NULL)
+		return (NULL);
+	if (p->tok->type != TOK_WORD || !is_name(p->tok->start, p->tok->len))
+	{
+		p->bad = p->tok;
+		return (NULL);
+	}
+	node->words = p->tok++;
+	node->n_words = 1;
+
+	skip_newlines(p);
+	if (reserved_word(p->tok) == R_IN)
+	{
+		items = node->child[1] = new_node(p, N_COMMAND);
+		if (items == NULL)
+			return (NULL);
+		items->words = ++p->tok;
+		while (p->tok->type == TOK_WORD)
+			p->tok++;
+		items->n_words = p->tok - items->words;
+		if (p->tok->type != TOK_SEMI && p->tok->type != TOK_NEWLINE)
+		{
+			p->bad = p->tok;
+			return (NULL);
+		}
+	}
+	if (p->tok->type == TOK_SEMI)
+		p->tok++;
+	skip_newlines(p);
+
+	if (!accept_word(p, R_DO))
+		return (NULL);
+	node->child[0] = parse_compound_list(p);
+	if (node->child[0] == NULL || !accept_word(p, R_DONE))
+		return (NULL);
+
+	return (node);
+}
+
+/**
+ * parse_compound - parses a compound command
+ * @p: the parser, at the reserved word starting the command
+ * @word: that reserved word
+ *
+ * Return: the command's node, NULL on errors
+ */
+node_t *parse_compound(parser_t *p, int word)
+{
+	if (word == R_IF)
+		return (parse_if(p));
+	if (word == R_FOR)
+		return (parse_for(p));
+	if (word == R_LBRACE)
+		return (parse_group(p));
+	if (word == R_CASE)
+		return (parse_case(p));
+
+	return (parse_loop(p));
+}
@@ -0,0 +1,64 @@
+#include "shell.h"
+
+/**
+ * parse_group - parses a list of commands grouped in braces
+ * @p: the parser, at the '{'
+ *
+ * Return: the group node, NULL on errors
+ */
+node_t *parse_group(parser_t *p)
+{
+	node_t *node = new_node(p, N_GROUP);
+
+	p->tok++;
+	if (node == NULL)
+		return (NULL);
+	node->child[0] = parse_compound_list(p);
+	if (node->child[0] == NULL || !accept_word(p, R_RBRACE))
+		return (NULL);
+
+	return (node);
+}
+
+/**
+ * parse_function - parses a function definition, name() compound-command
+ * @p: the parser, at the function's name
+ *
+ * Description: The body is parsed here, once. It is compiled with the rest
+ * of the input and only runs when the function is called.
+ *
+ * Return: the function node, NULL on errors
+ */
+node_t *parse_function(parser_t *p)
+{
+	node_t *node;
+	int word;
+
+	if (p->tok->flags != 0 || !is_name(p->tok->start, p->tok->len))
+	{
+		p->bad = p->tok;
+		return (NULL);
+	}
+	if (p->tok[2].type != TOK_RPAREN)
+	{
+		p->bad = &p->tok[2];
+		return (NULL);
+	}
+	node = new_node(p, N_FUNCTION);
+	if (node == NULL)
+		return (NULL);
+	node->words = p->tok;
+	node->n_words = 1;
+	p->tok += 3;
+
+	skip_newlines(p);
+	word = reserved_word(p->tok);
+	if (!starts_compound(word))
+	{
+		p->bad = p->tok;
+		return (NULL);
+	}
+	node->child[0] = parse_compound(p, word);
+
+	return ((node->child[0] != NULL) ? node : NULL);
+}
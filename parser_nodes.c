@@ -0,0 +1,113 @@
+#include "shell.h"
+
+/**
+ * new_node - hands out a zeroed syntax tree node
+ * @p: the parser
+ * @type: the kind of node
+ *
+ * Description: Nodes are taken from blocks owned by the parser. The blocks
+ * are kept when the parser is reset, so once the shell has seen its largest
+ * input, parsing does not allocate anymore.
+ *
+ * Return: the node, NULL if memory ran out
+ */
+node_t *new_node(parser_t *p, int type)
+{
+	node_chunk_t *chunk = p->current;
+	node_t *node;
+
+	if (chunk == NULL || chunk->used == NODE_CHUNK)
+	{
+		chunk = (chunk == NULL) ? p->chunks : chunk->next;
+		if (chunk == NULL)
+		{
+			chunk = malloc(sizeof(node_chunk_t));
+			if (chunk == NULL)
+			{
+				fprintf(stderr, "Not enough system memory to continue\n");
+				return (NULL);
+			}
+			chunk->next = NULL;
+			if (p->current == NULL)
+				p->chunks = chunk;
+			else
+				p->current->next = chunk;
+		}
+		chunk->used = 0;
+		p->current = chunk;
+	}
+
+	node = &chunk->nodes[chunk->used++];
+	memset(node, 0, sizeof(node_t));
+	node->type = type;
+
+	return (node);
+}
+
+/**
+ * reset_parser - gets the parser ready for a new input, the nodes of the
+ * previous input are recycled
+ * @p: the parser
+ */
+void reset_parser(parser_t *p)
+{
+	p->current = NULL;
+	p->tok = NULL;
+	p->bad = NULL;
+}
+
+/**
+ * free_parser - releases the node blocks of the parser
+ * @p: the parser
+ */
+void free_parser(parser_t *p)
+{
+	node_chunk_t *next;
+
+	while (p->chunks != NULL)
+	{
+		next = p->chunks->next;
+		safe_free(p->chunks);
+		p->chunks = next;
+	}
+	reset_parser(p);
+}
+
+/**
+ * skip_newlines - moves the parser past newline tokens
+ * @p: the parser
+ *
+ * Return: the number of newlines skipped
+ */
+int skip_newlines(parser_t *p)
+{
+	int count = 0;
+
+	while (p->tok->type == TOK_NEWLINE)
+	{
+		p->tok++;
+		count++;
+	}
+
+	return (count);
+}
+
+/**
+ * print_syntax_error - reports the syntax error found in the current line
+ * @hsh: contains all the data relevant to the shell's operation
+ */
+void print_syntax_error(shell_t *hsh)
+{
+	token_t *bad = hsh->parser.bad;
+
+	if (hsh->lexer.error != NULL)
+		fprintf(stderr, "%s: %lu: Syntax error: %s\n", hsh->prog_name,
+				hsh->cmd_count, hsh->lexer.error);
+	else if (bad->type == TOK_EOF || bad->type == TOK_NEWLINE)
+		fprintf(stderr, "%s: %lu: Syntax error: %s unexpected\n",
+				hsh->prog_name, hsh->cmd_count,
+				(bad->type == TOK_EOF) ? "end of file" : "newline");
+	else
+		fprintf(stderr, "%s: %lu: Syntax error: \"%.*s\" unexpected\n",
+				hsh->prog_name, hsh->cmd_count, (int)bad->len, bad->start);
+}
@@ -0,0 +1,71 @@
+#include "shell.h"
+
+/**
+ * reserved_word - tells which reserved word a token is
+ * @tok: the token
+ *
+ * Description: Only plain words can be reserved words, "if" or \if are
+ * ordinary words.
+ *
+ * Return: the reserved word (R_*), R_NONE if the token is not one
+ */
+int reserved_word(const token_t *tok)
+{
+	static const char *const words[] = {
+		NULL, "if", "then", "else", "elif", "fi", "while", "until", "for",
+		"in", "do", "done", "{", "}", "case", "esac"};
+	int i;
+
+	if (tok->type != TOK_WORD || tok->flags != 0 || tok->len > 5)
+		return (R_NONE);
+	for (i = R_IF; i <= R_ESAC; i++)
+	{
+		if (!_strncmp(tok->start, words[i], tok->len) &&
+			words[i][tok->len] == '\0')
+			return (i);
+	}
+
+	return (R_NONE);
+}
+
+/**
+ * accept_word - moves the parser past an expected reserved word
+ * @p: the parser
+ * @word: the reserved word (R_*)
+ *
+ * Return: 1 if the word was there, 0 otherwise (p->bad is set)
+ */
+int accept_word(parser_t *p, int word)
+{
+	if (reserved_word(p->tok) != word)
+	{
+		p->bad = p->tok;
+		return (0);
+	}
+	p->tok++;
+
+	return (1);
+}
+
+/**
+ * is_name - checks that a word is a valid variable name
+ * @word: the word
+ * @len: length of the word
+ *
+ * Return: 1 if it is made of letters, digits and underscores and does not
+ * start with a digit, 0 otherwise
+ */
+int is_name(const char *word, size_t len)
+{
+	size_t i;
+
+	if (len == 0 || isdigit(*word))
+		return (0);
+	for (i = 0; i < len; i++)
+	{
+		if (!isalpha(word[i]) && !isdigit(word[i]) && word[i] != '_')
+			return (0);
+	}
+
+	return (1);
+}
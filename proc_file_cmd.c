@@ -41,6 +41,7 @@ void handle_file_as_input(const char *filename, shell_t *hsh)
 {
 	size_t n = 0;
 	int n_read, fd;
+	program_t cached;
 
 	fd = open(filename, O_RDONLY);
 	if (fd == -1)
@@ -51,6 +52,15 @@ void handle_file_as_input(const char *filename, shell_t *hsh)
 		exit(CMD_NOT_FOUND);
 	}
 
+	if (open_script_cache(hsh, filename, fd, &cached) == 0)
+	{
+		close(fd);
+		hsh->prog_name = filename;
+		hsh->program = &cached; /* not freed, it is part of the mapping */
+		vm_run(hsh, hsh->program, 0);
+		handle_exit(hsh, multi_free);
+	}
+
 	n_read = _getline(&hsh->line, &n, fd);
 
 	/*
@@ -0,0 +1,116 @@
+#include "shell.h"
+
+/**
+ * grow_buffer - makes room for one more element in a program buffer
+ * @prog: the program, its oom flag is set on failure
+ * @buf: the buffer
+ * @count: number of elements in the buffer
+ * @size: capacity of the buffer, updated
+ * @elem: size of an element
+ *
+ * Return: 0 on success, -1 if memory ran out
+ */
+int grow_buffer(program_t *prog, void **buf, size_t count, size_t *size,
+				size_t elem)
+{
+	size_t new_size = (*size == 0) ? 64 : *size * 2;
+	void *grown;
+
+	if (count < *size)
+		return (0);
+	grown = _realloc(*buf, *size * elem, new_size * elem);
+	if (grown == NULL)
+	{
+		prog->oom = 1;
+		return (-1);
+	}
+	*buf = grown;
+	*size = new_size;
+
+	return (0);
+}
+
+/**
+ * emit - appends an instruction to a program
+ * @prog: the program
+ * @op: the operation
+ * @a: first operand
+ * @b: second operand
+ *
+ * Return: the index of the instruction, -1 if memory ran out
+ */
+int32_t emit(program_t *prog, int op, int32_t a, int32_t b)
+{
+	insn_t *in;
+
+	if (grow_buffer(prog, (void **)&prog->code, prog->n_code, &prog->code_size,
+			 sizeof(insn_t)) == -1)
+		return (-1);
+	in = &prog->code[prog->n_code];
+	in->op = op;
+	in->a = a;
+	in->b = b;
+
+	return (prog->n_code++);
+}
+
+/**
+ * add_string - copies a string to the strings of a program
+ * @prog: the program
+ * @str: the string
+ * @len: length of the string
+ *
+ * Return: the offset of the copy, -1 if memory ran out
+ */
+int32_t add_string(program_t *prog, const char *str, size_t len)
+{
+	size_t offset = prog->strings_len;
+
+	while (prog->strings_size - prog->strings_len <= len)
+	{
+		if (grow_buffer(prog, (void **)&prog->strings, prog->strings_size,
+				 &prog->strings_size, 1) == -1)
+			return (-1);
+	}
+	_memcpy(prog->strings + offset, str, len);
+	prog->strings[offset + len] = '\0';
+	prog->strings_len += len + 1;
+
+	return (offset);
+}
+
+/**
+ * reset_program - empties a program, its buffers are kept
+ * @prog: the program
+ *
+ * Description: The names of its commands are dropped, the words they were
+ * found at are about to be others.
+ */
+void reset_program(program_t *prog)
+{
+	safe_free(prog->names);
+	prog->n_code = 0;
+	prog->n_words = 0;
+	prog->strings_len = 0;
+	prog->oom = 0;
+}
+
+/**
+ * free_program - releases the buffers of a program
+ * @prog: the program
+ */
+void free_program(program_t *prog)
+{
+	/* the buffers of a program mapped from a file are not its own */
+	if (prog->code_size == 0)
+	{
+		prog->code = NULL;
+		prog->words = NULL;
+		prog->strings = NULL;
+	}
+	safe_free(prog->code);
+	safe_free(prog->words);
+	safe_free(prog->strings);
+	prog->code_size = prog->words_size = prog->strings_size = 0;
+	reset_program(prog);
+}
@@ -0,0 +1,133 @@
+#include "shell.h"
+
+/**
+ * check_assigns - checks the words of a mapped assignment instruction
+ * @prog: the program
+ * @in: the OP_ASSIGN or OP_OVERLAY instruction
+ *
+ * Description: Each word must start with a name and '=', as the compiler
+ * wrote it, since the assignment is cut there when it runs.
+ *
+ * Return: 1 if they can be assigned, 0 otherwise
+ */
+static int check_assigns(const program_t *prog, const insn_t *in)
+{
+	const char *word, *eq;
+	int32_t i;
+
+	if (in->a < 0 || in->b < 0 || (size_t)in->a + in->b > prog->n_words)
+		return (0);
+	for (i = 0; i < in->b; i++)
+	{
+		word = prog->strings + WORD_OFFSET(prog->words[in->a + i]);
+		eq = _strchr(word, '=');
+		if (eq == NULL || !is_name(word, eq - word))
+			return (0);
+	}
+
+	return (1);
+}
+
+/**
+ * check_insn - checks that an instruction of a mapped program is sound
+ * @prog: the program
+ * @in: the instruction
+ *
+ * Return: 1 if it can be executed, 0 otherwise
+ */
+static int check_insn(const program_t *prog, const insn_t *in)
+{
+	int32_t n_code = prog->n_code, i;
+
+	switch (in->op)
+	{
+	case OP_HALT:
+	case OP_EXEC:
+	case OP_NOT:
+	case OP_STAGE_END:
+	case OP_SET:
+	case OP_SAVE:
+	case OP_ENDLOOP:
+	case OP_PARAMS:
+		return (1);
+	case OP_ASSIGN:
+	case OP_OVERLAY:
+		return (check_assigns(prog, in));
+	case OP_ARGV:
+	case OP_EXPAND:
+		return (in->a >= 0 && in->b >= 0 &&
+				(size_t)in->a + in->b <= prog->n_words);
+	case OP_LOOP:
+		return (in->a != 2 || (in->b >= 0 && (size_t)in->b < prog->strings_len));
+	case OP_BUILTIN:
+		return (in->a >= 0 && in->a < N_BUILTINS);
+	case OP_ALIAS:
+	case OP_ARITH:
+		return (in->a >= 0 && (size_t)in->a < prog->strings_len);
+	case OP_NEXT:
+	case OP_DEFUN:
+		return (in->a >= 0 && in->a < n_code && in->b >= 0 &&
+				(size_t)in->b < prog->strings_len);
+	case OP_CASE:
+		if (in->a < 0 || in->b < 0 ||
+			(size_t)(in - prog->code) + in->a + in->b >= prog->n_code)
+			return (0);
+		for (i = 1; i <= in->a + in->b; i++)
+		{
+			if ((i <= in->a && in[i].op != OP_ARM) ||
+				(i > in->a && in[i].op != OP_GLOB && in[i].op != OP_GLOBVAR))
+				return (0);
+		}
+		return (1);
+	case OP_ARM:
+		if (in->a == -1)
+			return (in->b >= 0 && in->b < n_code);
+		/* fall through */
+	case OP_GLOB:
+	case OP_GLOBVAR:
+		return (in->a >= 0 && (size_t)in->a < prog->strings_len &&
+				in->b >= 0 && in->b < n_code);
+	case OP_BREAK:
+		return (in->a >= 0 && in->a < n_code && in->b >= 0);
+	case OP_JMP:
+	case OP_JZ:
+	case OP_JNZ:
+	case OP_PIPE:
+	case OP_STAGE:
+		return (in->a >= 0 && in->a < n_code);
+	}
+
+	return (0);
+}
+
+/**
+ * check_program - checks a program mapped from a cache file or a snapshot
+ * @prog: the program
+ *
+ * Description: The file could have been damaged or tampered with. Every
+ * jump, word and builtin must be in range, every string terminated and
+ * every assignment start with a name and '=', so that running it cannot
+ * stray outside the mapping.
+ *
+ * Return: 1 if it can be executed, 0 otherwise
+ */
+int check_program(const program_t *prog)
+{
+	size_t i;
+
+	if (prog->strings[prog->strings_len - 1] != '\0' ||
+		prog->code[prog->n_code - 1].op != OP_HALT)
+		return (0);
+	for (i = 0; i < prog->n_words; i++)
+	{
+		if (WORD_OFFSET(prog->words[i]) >= prog->strings_len)
+			return (0);
+	}
+	for (i = 0; i < prog->n_code; i++)
+	{
+		if (!check_insn(prog, &prog->code[i]))
+			return (0);
+	}
+
+	return (1);
+}
@@ -0,0 +1,198 @@
+#include "shell.h"
+
+/**
+ * compile_prompt - compiles a PS1 template into the pieces of the prompt
+ * @prompt: the prompt, its old pieces are replaced
+ * @ps1: the template
+ *
+ * Description: \u, \h, \w, \W and \$ stand for the user, the host, the
+ * working directory, its last component and the prompt sign, \\ and \n for
+ * a backslash and a newline. Anything else is text, kept as it is.
+ *
+ * Return: 0 on success, -1 if memory ran out
+ */
+static int compile_prompt(prompt_t *prompt, const char *ps1)
+{
+	static const char escapes[] = "uhwW$";
+	size_t len = _strlen(ps1), n = 0, at = 0;
+	prompt_part_t *parts = malloc((len + 1) * sizeof(prompt_part_t));
+	char *text = malloc(len + 1), *copy = _strdup(ps1), *esc, c;
+	int type;
+
+	if (parts == NULL || text == NULL || copy == NULL)
+	{
+		multi_free("sss", parts, text, copy);
+		return (-1);
+	}
+	for (; *ps1 != '\0'; ps1++)
+	{
+		esc = (*ps1 == '\\' && ps1[1] != '\0') ?
+			_strchr(escapes, ps1[1]) : NULL;
+		type = esc ? PS_USER + (esc - escapes) : PS_TEXT;
+		c = *ps1;
+		if (!esc && c == '\\' && (ps1[1] == '\\' || ps1[1] == 'n'))
+			c = (*++ps1 == 'n') ? '\n' : '\\';
+		if (type != PS_TEXT || n == 0 || parts[n - 1].type != PS_TEXT)
+		{
+			parts[n].type = type;
+			parts[n].start = at;
+			parts[n++].len = 0;
+		}
+		if (type != PS_TEXT)
+			ps1++;
+		else
+		{
+			text[at++] = c;
+			parts[n - 1].len++;
+		}
+	}
+	multi_free("sss", prompt->ps1, prompt->text, prompt->parts);
+	prompt->ps1 = copy;
+	prompt->text = text;
+	prompt->parts = parts;
+	prompt->n_parts = n;
+
+	return (0);
+}
+
+/**
+ * put_text - adds text to the rendered prompt
+ * @prompt: the prompt
+ * @at: where the text goes in the prompt, moved past it
+ * @text: the text, not necessarily NUL-terminated
+ * @len: its length
+ *
+ * Return: 0 on success, -1 if memory ran out
+ */
+static int put_text(prompt_t *prompt, size_t *at, const char *text,
+					size_t len)
+{
+	size_t size = prompt->out_size ? prompt->out_size : 128;
+	char *out;
+
+	while (*at + len + 1 > size)
+		size *= 2;
+	if (size != prompt->out_size)
+	{
+		out = _realloc(prompt->out, prompt->out_size, size);
+		if (out == NULL)
+			return (-1);
+		prompt->out = out;
+		prompt->out_size = size;
+	}
+	_memcpy(prompt->out + *at, text, len);
+	*at += len;
+	prompt->out[*at] = '\0';
+
+	return (0);
+}
+
+/**
+ * put_part - adds a piece of the prompt to the rendered prompt
+ * @prompt: the prompt
+ * @at: where the piece goes in the prompt, moved past it
+ * @part: the piece
+ * @env: the variables the escapes are taken from
+ *
+ * Return: 0 on success, -1 if memory ran out
+ */
+static int put_part(prompt_t *prompt, size_t *at, const prompt_part_t *part,
+					const env_t *env)
+{
+	const char *pwd = _getenv(env, "PWD"), *home = _getenv(env, "HOME");
+	size_t home_len = (home != NULL) ? _strlen(home) : 0;
+	const char *s = NULL;
+
+	if (part->type == PS_TEXT)
+		return (put_text(prompt, at, prompt->text + part->start,
+					part->len));
+	if (part->type == PS_USER)
+		s = _getenv(env, "USER");
+	else if (part->type == PS_HOST)
+		s = prompt->host;
+	else if (part->type == PS_SIGN)
+		s = (geteuid() == 0) ? "#" : "$";
+	else if (pwd != NULL && home_len > 1 &&
+			 !_strncmp(pwd, home, home_len) &&
+			 (pwd[home_len] == '\0' ||
+			  (part->type == PS_CWD && pwd[home_len] == '/')))
+	{
+		if (put_text(prompt, at, "~", 1) == -1)
+			return (-1);
+		s = (part->type == PS_CWD) ? pwd + home_len : NULL;
+	}
+	else if (pwd != NULL)
+	{
+		s = pwd;
+		if (part->type == PS_DIR && _strrchr(pwd, '/') != NULL &&
+			_strcmp(pwd, "/"))
+			s = _strrchr(pwd, '/') + 1;
+	}
+	if (s == NULL)
+		s = "";
+
+	return (put_text(prompt, at, s, _strlen(s)));
+}
+
+/**
+ * show_prompt - shows the prompt in interactive mode
+ * @hsh: shell data
+ *
+ * Description: Scripts and pipes get no prompt and nothing is worked out
+ * for them. The template is compiled when PS1 changes, the host name is
+ * asked for once, and the prompt is rendered again only once a variable
+ * has changed: otherwise the one shown last is shown as it is.
+ */
+void show_prompt(shell_t *hsh)
+{
+	prompt_t *prompt = &hsh->prompt;
+	const char *ps1;
+	struct utsname name;
+	size_t at = 0, i;
+	int ret;
+
+	if (!hsh->interactive)
+		return;
+	if (prompt->out == NULL || prompt->gen != hsh->env.gen)
+	{
+		ps1 = _getenv(&hsh->env, "PS1");
+		if (ps1 == NULL)
+			ps1 = (_getenv(&hsh->env, "USER") != NULL) ? DEFAULT_PS1
+				: PLAIN_PS1;
+		if (prompt->host == NULL && uname(&name) == 0)
+		{
+			for (i = 0; name.nodename[i] != '\0'; i++)
+				if (name.nodename[i] == '.')
+					name.nodename[i] = '\0';
+			prompt->host = _strdup(name.nodename);
+		}
+		ret = (prompt->ps1 == NULL || _strcmp(ps1, prompt->ps1)) ?
+			compile_prompt(prompt, ps1) : 0;
+		if (ret == 0)
+			ret = put_text(prompt, &at, "", 0);
+		for (i = 0; ret == 0 && i < prompt->n_parts; i++)
+			ret = put_part(prompt, &at, prompt->parts + i,
+					&hsh->env);
+		if (ret == -1)
+		{
+			safe_free(prompt->out);
+			prompt->out_size = 0;
+		}
+		prompt->gen = hsh->env.gen;
+	}
+	printf("%s", (prompt->out != NULL) ? prompt->out : PLAIN_PS1);
+}
+
+/**
+ * free_prompt - frees the compiled and rendered prompt
+ * @prompt: the prompt
+ */
+void free_prompt(prompt_t *prompt)
+{
+	multi_free("ssss", prompt->ps1, prompt->text, prompt->parts,
+			   prompt->host);
+	safe_free(prompt->out);
+	prompt->ps1 = prompt->text = prompt->host = NULL;
+	prompt->parts = NULL;
+	prompt->n_parts = prompt->out_size = 0;
+}
@@ -0,0 +1,48 @@
+#include "shell.h"
+
+/**
+ * rc_path - works out the startup file of an interactive shell
+ * @hsh: contains all the data relevant to the shell's operation
+ *
+ * Return: the value of ENV if it is set and not empty, else ~/.hshrc, in a
+ * new string, NULL if there is no home directory or memory ran out
+ */
+static char *rc_path(shell_t *hsh)
+{
+	char *env = _getenv(&hsh->env, "ENV"), *home, *path;
+
+	if (env != NULL && *env != '\0')
+		return (_strdup(env));
+	home = _getenv(&hsh->env, "HOME");
+	if (home == NULL || *home == '\0')
+		return (NULL);
+	path = malloc(_strlen(home) + sizeof(RC_FILE) + 1);
+	if (path != NULL)
+		sprintf(path, "%s/%s", home, RC_FILE);
+
+	return (path);
+}
+
+/**
+ * load_rc - runs the startup file of an interactive shell
+ * @hsh: contains all the data relevant to the shell's operation
+ *
+ * Description: The file is read at once and run like a script, in the
+ * shell's process, so the aliases, functions and variables it defines are
+ * there for the commands typed afterwards. A missing file is not an error.
+ */
+void load_rc(shell_t *hsh)
+{
+	char *path = rc_path(hsh);
+	int fd = (path != NULL) ? open(path, O_RDONLY) : -1;
+	size_t n = 0;
+
+	safe_free(path);
+	if (fd == -1)
+		return;
+	if (_getline(&hsh->line, &n, fd) > 0)
+		hsh->exit_code = parse_line(hsh);
+	close(fd);
+	/* the commands read next go to a buffer of their own */
+	safe_free(hsh->line);
+}
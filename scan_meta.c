@@ -0,0 +1,158 @@
+#include "shell.h"
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define SCAN_SIMD
+#endif
+
+/* the bytes each scan stops at, besides '\0' */
+static const char *const meta_chars[N_META] = {
+	"\t\n \"#$&'()*;?[\\{|", /* META_WORD */
+	"\"$\\",			 /* META_DQUOTE */
+	"'",				 /* META_SQUOTE */
+	"\n"				 /* META_LINE */
+};
+
+/*
+ * A byte b is in set s when meta_lo[s][b & 15] & meta_hi[s][b >> 4] is not
+ * 0: each bit of the tables stands for the high nibble of some of the bytes.
+ */
+static unsigned char meta_lo[N_META][16];
+static unsigned char meta_hi[N_META][16];
+
+/**
+ * init_meta - fills the nibble tables of the sets
+ *
+ * Description: A set may hold bytes with 8 different high nibbles at most.
+ */
+static void init_meta(void)
+{
+	const char *c;
+	unsigned char bit;
+	int set;
+
+	for (set = 0; set < N_META; set++)
+	{
+		meta_hi[set][0] = meta_lo[set][0] = 1; /* '\0' */
+		bit = 2;
+		for (c = meta_chars[set]; *c != '\0'; c++)
+		{
+			if (meta_hi[set][(unsigned char)*c >> 4] == 0)
+			{
+				meta_hi[set][(unsigned char)*c >> 4] = bit;
+				bit <<= 1;
+			}
+			meta_lo[set][*c & 0x0f] |= meta_hi[set][(unsigned char)*c >> 4];
+		}
+	}
+}
+
+#ifdef SCAN_SIMD
+
+/**
+ * find_meta_sse2 - finds the next byte of a set, 16 bytes at a time
+ * @p: where to start
+ * @set: the set
+ *
+ * Return: a pointer to the byte
+ */
+static NO_ASAN char *find_meta_sse2(const char *p, int set)
+{
+	const char *block = (const char *)((uintptr_t)p & ~(uintptr_t)15), *c;
+	unsigned int mask, skip = p - block;
+	__m128i bytes, hits;
+
+	for (;; block += 16, skip = 0)
+	{
+		bytes = _mm_load_si128((const __m128i *)block);
+		hits = _mm_cmpeq_epi8(bytes, _mm_setzero_si128());
+		for (c = meta_chars[set]; *c != '\0'; c++)
+			hits = _mm_or_si128(hits, _mm_cmpeq_epi8(bytes, _mm_set1_epi8(*c)));
+		mask = (unsigned int)_mm_movemask_epi8(hits) >> skip;
+		if (mask != 0)
+			return ((char *)block + skip + __builtin_ctz(mask));
+	}
+}
+
+/**
+ * find_meta_avx2 - finds the next byte of a set, 32 bytes at a time
+ * @p: where to start
+ * @set: the set
+ *
+ * Description: Both nibbles of every byte are looked up in the set's tables
+ * at once, with a shuffle each.
+ *
+ * Return: a pointer to the byte
+ */
+static NO_ASAN __attribute__((target("avx2"))) char *
+find_meta_avx2(const char *p, int set)
+{
+	const char *block = (const char *)((uintptr_t)p & ~(uintptr_t)31);
+	unsigned int mask, skip = p - block;
+	__m256i lo = _mm256_broadcastsi128_si256(
+				_mm_loadu_si128((const __m128i *)meta_lo[set])),
+			hi = _mm256_broadcastsi128_si256(
+				_mm_loadu_si128((const __m128i *)meta_hi[set])),
+			nibble = _mm256_set1_epi8(0x0f), bytes, classes;
+
+	for (;; block += 32, skip = 0)
+	{
+		bytes = _mm256_load_si256((const __m256i *)block);
+		classes = _mm256_and_si256(
+			_mm256_shuffle_epi8(lo, _mm256_and_si256(bytes, nibble)),
+			_mm256_shuffle_epi8(hi, _mm256_and_si256(
+										_mm256_srli_epi16(bytes, 4), nibble)));
+		mask = ~(unsigned int)_mm256_movemask_epi8(
+				   _mm256_cmpeq_epi8(classes, _mm256_setzero_si256())) >> skip;
+		if (mask != 0)
+			return ((char *)block + skip + __builtin_ctz(mask));
+	}
+}
+
+#else
+
+/**
+ * find_meta_scalar - finds the next byte of a set, one byte at a time
+ * @p: where to start
+ * @set: the set
+ *
+ * Return: a pointer to the byte
+ */
+static char *find_meta_scalar(const char *p, int set)
+{
+	while (!(meta_lo[set][*p & 0x0f] & meta_hi[set][(unsigned char)*p >> 4]))
+		p++;
+
+	return ((char *)p);
+}
+
+#endif
+
+/**
+ * find_meta - finds the next byte the lexer has to look at
+ * @p: where to start, in a NUL-terminated string
+ * @set: META_WORD in words, META_DQUOTE or META_SQUOTE between quotes,
+ *       META_LINE in comments
+ *
+ * Description: The bytes in between are skipped with SSE2, or AVX2 when the
+ * CPU has it, chosen on the first call. Other targets go one byte at a time.
+ *
+ * Return: a pointer to the byte, the terminating '\0' if there is none
+ */
+char *find_meta(const char *p, int set)
+{
+	static char *(*scan)(const char *, int);
+
+	if (scan == NULL)
+	{
+		init_meta();
+#ifdef SCAN_SIMD
+		scan = __builtin_cpu_supports("avx2") ? find_meta_avx2
+											  : find_meta_sse2;
+#else
+		scan = find_meta_scalar;
+#endif
+	}
+
+	return (scan(p, set));
+}
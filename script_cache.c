@@ -0,0 +1,118 @@
+#include "shell.h"
+
+/**
+ * cache_file_name - builds the name of the cache file of a script
+ * @dir: the cache directory
+ * @filename: the script
+ *
+ * Description: The file is named after a hash of the script's absolute path.
+ * Two scripts sharing a name just evict each other, the key stored in the
+ * file tells them apart.
+ *
+ * Return: the name, to be freed, NULL on failure
+ */
+static char *cache_file_name(const char *dir, const char *filename)
+{
+	char *abs_path = realpath(filename, NULL), *name;
+	unsigned long hash;
+
+	if (abs_path == NULL)
+		return (NULL);
+	hash = hash_name(abs_path);
+	free(abs_path);
+
+	name = malloc(_strlen(dir) + 24);
+	if (name != NULL)
+		sprintf(name, "%s/%016lx.hshc", dir, hash);
+
+	return (name);
+}
+
+/**
+ * check_header - checks that a cache file is whole and matches the script
+ * @hdr: the header of the mapped file
+ * @size: size of the mapped file
+ * @key: the script's status
+ *
+ * Return: 1 if the file can be used, 0 otherwise
+ */
+static int check_header(const cache_header_t *hdr, size_t size,
+						const struct stat *key)
+{
+	if (size < sizeof(cache_header_t) || memcmp(hdr->magic, CACHE_MAGIC, 4) ||
+		hdr->version != CACHE_VERSION)
+		return (0);
+	if (hdr->dev != (uint64_t)key->st_dev || hdr->ino != (uint64_t)key->st_ino ||
+		hdr->size != (uint64_t)key->st_size ||
+		hdr->mtime_sec != (int64_t)key->st_mtim.tv_sec ||
+		hdr->mtime_nsec != (int64_t)key->st_mtim.tv_nsec)
+		return (0);
+	if (hdr->n_code == 0 || hdr->strings_len == 0 ||
+		hdr->strings_len > UINT32_MAX)
+		return (0);
+
+	return (size == sizeof(cache_header_t) + hdr->n_code * sizeof(insn_t) +
+						hdr->n_words * sizeof(uint32_t) + hdr->strings_len);
+}
+
+/**
+ * open_script_cache - looks a script up in the script cache
+ * @hsh: contains all the data relevant to the shell's operation
+ * @filename: the script
+ * @fd: the script, opened
+ * @prog: where to store the cached program
+ *
+ * Description: Caching is on when HSH_CACHE_DIR names a directory. The
+ * compiled script is then kept there, and later runs of the unchanged
+ * script (same device, inode, size and modification time) map it and run
+ * it as it is, without reading, parsing or compiling the script again.
+ *
+ * Return: 0 if @prog was loaded from the cache, -1 if the script has to be
+ * parsed. In that case hsh->cache.path is set if it should be saved.
+ */
+int open_script_cache(shell_t *hsh, const char *filename, int fd,
+					  program_t *prog)
+{
+	script_cache_t *cache = &hsh->cache;
+	char *dir = _getenv(&hsh->env, "HSH_CACHE_DIR");
+	cache_header_t *hdr;
+	struct stat st;
+	int cache_fd;
+
+	if (dir == NULL || *dir == '\0' || fstat(fd, &cache->key) == -1 ||
+		!S_ISREG(cache->key.st_mode))
+		return (-1);
+	cache->path = cache_file_name(dir, filename);
+	cache_fd = (cache->path == NULL) ? -1 : open(cache->path, O_RDONLY);
+	if (cache_fd == -1)
+		return (-1);
+	if (fstat(cache_fd, &st) == 0 && st.st_size > 0)
+	{
+		cache->map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, cache_fd, 0);
+		cache->map_size = st.st_size;
+	}
+	close(cache_fd);
+	if (cache->map == MAP_FAILED || cache->map == NULL)
+	{
+		cache->map = NULL;
+		return (-1);
+	}
+
+	hdr = cache->map;
+	memset(prog, 0, sizeof(program_t));
+	if (check_header(hdr, cache->map_size, &cache->key))
+	{
+		prog->code = (insn_t *)(hdr + 1);
+		prog->n_code = hdr->n_code;
+		prog->words = (uint32_t *)(prog->code + hdr->n_code);
+		prog->n_words = hdr->n_words;
+		prog->strings = (char *)(prog->words + hdr->n_words);
+		prog->strings_len = hdr->strings_len;
+		if (check_program(prog))
+			return (0);
+	}
+	munmap(cache->map, cache->map_size);
+	cache->map = NULL;
+
+	return (-1);
+}
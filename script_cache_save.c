@@ -0,0 +1,90 @@
+#include "shell.h"
+
+/**
+ * write_all - writes a whole buffer to a file
+ * @fd: the file
+ * @data: the buffer
+ * @size: size of the buffer
+ *
+ * Return: 0 on success, -1 on failure
+ */
+int write_all(int fd, const void *data, size_t size)
+{
+	const char *p = data;
+	ssize_t n;
+
+	while (size > 0)
+	{
+		n = write(fd, p, size);
+		if (n == -1)
+			return (-1);
+		p += n;
+		size -= n;
+	}
+
+	return (0);
+}
+
+/**
+ * save_script_cache - saves the compiled script to its cache file
+ * @hsh: contains all the data relevant to the shell's operation
+ * @prog: the compiled script
+ *
+ * Description: The file is written aside and renamed over the old one, so
+ * shells running the same script at once never see half of it. Failures
+ * are silent, the script is just compiled again the next time it runs.
+ *
+ * Return: 0 on success, -1 on failure
+ */
+int save_script_cache(shell_t *hsh, const program_t *prog)
+{
+	script_cache_t *cache = &hsh->cache;
+	char *tmp = malloc(_strlen(cache->path) + 8);
+	cache_header_t hdr;
+	int fd, ret = -1;
+
+	if (tmp == NULL)
+		return (-1);
+	memset(&hdr, 0, sizeof(hdr));
+	memcpy(hdr.magic, CACHE_MAGIC, 4);
+	hdr.version = CACHE_VERSION;
+	hdr.dev = cache->key.st_dev;
+	hdr.ino = cache->key.st_ino;
+	hdr.size = cache->key.st_size;
+	hdr.mtime_sec = cache->key.st_mtim.tv_sec;
+	hdr.mtime_nsec = cache->key.st_mtim.tv_nsec;
+	hdr.n_code = prog->n_code;
+	hdr.n_words = prog->n_words;
+	hdr.strings_len = prog->strings_len;
+
+	sprintf(tmp, "%s.XXXXXX", cache->path);
+	fd = mkstemp(tmp);
+	if (fd != -1)
+	{
+		if (write_all(fd, &hdr, sizeof(hdr)) == 0 &&
+			write_all(fd, prog->code, prog->n_code * sizeof(insn_t)) == 0 &&
+			write_all(fd, prog->words, prog->n_words * sizeof(uint32_t)) == 0 &&
+			write_all(fd, prog->strings, prog->strings_len) == 0)
+			ret = 0;
+		if (close(fd) == -1 || ret == -1 || rename(tmp, cache->path) == -1)
+		{
+			unlink(tmp);
+			ret = -1;
+		}
+	}
+	safe_free(tmp);
+
+	return (ret);
+}
+
+/**
+ * free_script_cache - releases the cache entry of the script being run
+ * @cache: the cache entry
+ */
+void free_script_cache(script_cache_t *cache)
+{
+	if (cache->map != NULL)
+		munmap(cache->map, cache->map_size);
+	cache->map = NULL;
+	safe_free(cache->path);
+}
@@ -7,16 +7,20 @@
 #ifndef SHELL_H
 #define SHELL_H
 
+#include <dirent.h>
 #include <errno.h>
 #include <fcntl.h>
-#include <regex.h>
+#include <pthread.h>
 #include <stdarg.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <signal.h>
+#include <stdint.h>
 #include <string.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <sys/utsname.h>
 #include <sys/wait.h>
 #include <unistd.h>
 
@@ -25,13 +29,13 @@
 #define BUFF_SIZE 1024
 #define SPACE ' '
 #define CMD_NOT_FOUND 127
-#define PROMPT_SIZE 4096
 #define PATH_SIZE 2048
 #define NOT_BUILTIN 18
 #define RUNNING 1
 #define CMD_ERR 2
-#define MAX_ALIAS_LENGTH 50
-#define MAX_VALUE_LENGTH 2048
+#define INCOMPLETE -2 /* the input stops in the middle of a command */
+#define RC_FILE ".hshrc" /* read from $HOME by interactive shells */
+#define MAX_CALL_DEPTH 1000 /* nested function calls */
 
 /* Function Macros - Macros related to function operations. */
 
@@ -41,9 +45,39 @@
 #define isnegative(c) (((c) == '-') ? -1 : 1)
 #define issign(c) ((c) == '-' || (c) == '+')
 #define isquote(c) ((c) == '"' || (c) == '\'')
+#define isblank(c) ((c) == SPACE || (c) == '\t')
+#define isoperator(p) (*(p) == '\n' || *(p) == ';' || *(p) == '|' || \
+					   *(p) == '(' || *(p) == ')' || \
+					   (*(p) == '&' && (p)[1] == '&'))
+#define isword_end(p) (*(p) == '\0' || isblank(*(p)) || isoperator(p))
 
 /* String Handlers - Functions for handling string operations. */
 
+/*
+ * The string kernels go through memory a word at a time. A word holds a 0
+ * byte when has_zero() is not 0. Aligned words never cross a page, so whole
+ * words are read even past the end of a string, which the address sanitizer
+ * must not report.
+ */
+#ifdef __GNUC__
+typedef size_t __attribute__((may_alias)) word_t;
+typedef size_t __attribute__((may_alias, aligned(1))) uword_t;
+#else
+typedef size_t word_t;
+typedef size_t uword_t;
+#endif
+#ifdef __SANITIZE_ADDRESS__
+#define NO_ASAN __attribute__((no_sanitize_address))
+#else
+#define NO_ASAN
+#endif
+#define WORD_SIZE sizeof(size_t)
+#define WORD_ONES ((size_t)-1 / 0xff)
+#define WORD_HIGHS (WORD_ONES * 0x80)
+#define has_zero(w) (((w) - WORD_ONES) & ~(w) & WORD_HIGHS)
+#define word_aligned(p) (((uintptr_t)(p) & (WORD_SIZE - 1)) == 0)
+#define STRSTR_TRIES 4 /* direct comparisons before _strstr() goes two-way */
+
 size_t _strlen(const char *s);
 char *_strdup(const char *str);
 char *_strchr(const char *s, int c);
@@ -51,8 +85,6 @@ char *_strrchr(const char *s, int c);
 char *_strcpy(char *dest, const char *src);
 char *_strcat(char *dest, const char *src);
 int _strcmp(const char *s1, const char *s2);
-char **duplicate_str_array(char **original);
-void concatenate_arrays(char ***dest, char **src);
 char *_strpbrk(const char *s, const char *accept);
 size_t _strspn(const char *s, const char *accept);
 char **_strtok(const char *str, const char *delim);
@@ -65,6 +97,7 @@ char *_strstr(const char *haystack, const char *needle);
 
 int _atoi(const char *s);
 void _itoa(size_t n, char *s);
+void _imtoa(intmax_t n, char *s);
 void _reverse(char *buffer, size_t len);
 
 /* memory handlers */
@@ -81,19 +114,172 @@ void _free(void **ptr);
 /* frees memory for a variable number of objects */
 void multi_free(const char *format, ...);
 
-/* a custom implementation of the getline function */
-ssize_t _getline(char **lineptr, size_t *n, int fd);
+/* arena - memory for what only lives while a command runs */
+
+#define ARENA_CHUNK 4096
+#define ARENA_ALIGN sizeof(void *)
+
+/**
+ * struct arena_chunk - A block of arena memory, the memory follows it.
+ * @next: The next block.
+ * @size: Number of bytes in the block.
+ * @used: Number of bytes handed out.
+ */
+
+typedef struct arena_chunk
+{
+	struct arena_chunk *next;
+	size_t size;
+	size_t used;
+} arena_chunk_t;
 
-/* shows the prompt in interactive mode */
-void show_prompt(void);
+/**
+ * struct arena - A bump allocator, its blocks are kept when released.
+ * @chunks: The blocks.
+ * @current: The block memory is taken from, NULL when none is in use.
+ */
+
+typedef struct arena
+{
+	arena_chunk_t *chunks;
+	arena_chunk_t *current;
+} arena_t;
 
-/* retrieves the hostname from the '/etc/hostname' file */
-char *get_hostname(char *buffer);
+/**
+ * struct arena_mark - How much of an arena was in use at some point.
+ * @chunk: The block in use, NULL if none was.
+ * @used: Number of bytes used in that block.
+ */
+
+typedef struct arena_mark
+{
+	arena_chunk_t *chunk;
+	size_t used;
+} arena_mark_t;
+
+void *arena_alloc(arena_t *a, size_t size);
+char *arena_strdup(arena_t *a, const char *str);
+arena_mark_t arena_mark(const arena_t *a);
+void arena_release(arena_t *a, arena_mark_t mark);
+void free_arena(arena_t *a);
+
+/* intern - names stored once, compared by pointer */
+
+#define INTERN_MIN 64
+
+/**
+ * struct interned - A slot of the intern table.
+ * @name: The name, NULL for a free slot.
+ * @hash: Hash of the name.
+ */
+
+typedef struct interned
+{
+	const char *name;
+	unsigned long hash;
+} interned_t;
+
+/**
+ * struct intern_table - The interned names, in an open addressing hash table.
+ * @slots: The slots, a power of 2 of them.
+ * @size: Number of slots.
+ * @count: Number of names.
+ * @strings: The names' characters, never given back.
+ */
+
+typedef struct intern_table
+{
+	interned_t *slots;
+	size_t size;
+	size_t count;
+	arena_t strings;
+} intern_table_t;
+
+const char *intern(const char *name);
+const char *find_interned(const char *name);
+void free_interned(void);
+
+/* a custom implementation of the getline function */
+ssize_t _getline(char **lineptr, size_t *n, int fd);
 
 /* environment and PATH handlers */
 
 extern char **environ;
 
+#define ENV_MIN 64
+
+/* attributes of a variable */
+#define VAR_EXPORT 1   /* given to the programs the shell runs */
+#define VAR_READONLY 2 /* cannot be set or unset any more */
+#define VAR_UNSET 4	   /* declared by export or readonly, without a value */
+#define var_exported(f) (((f) & (VAR_EXPORT | VAR_UNSET)) == VAR_EXPORT)
+
+/**
+ * struct env_var - A slot of the variable table.
+ * @entry: The variable as children get it, "NAME=value", NULL for a free
+ *         slot.
+ * @name_len: Length of the name.
+ * @size: Size of the entry's buffer, a value that fits is written in place.
+ * @hash: Hash of the name.
+ * @flags: Attributes of the variable (VAR_*).
+ */
+
+typedef struct env_var
+{
+	char *entry;
+	size_t name_len;
+	size_t size;
+	unsigned long hash;
+	int flags;
+} env_var_t;
+
+/**
+ * struct env - The shell's variables, in an open addressing hash table.
+ *              Those flagged VAR_EXPORT are the environment of its children.
+ * @slots: The slots, a power of 2 of them.
+ * @size: Number of slots.
+ * @count: Number of variables.
+ * @envp: The exported entries in an array for execve(), built when a
+ *        program is run.
+ * @stale: Whether exported variables were added or removed since @envp was
+ *         built.
+ * @overlay: The "NAME=value" assignments in front of the running commands,
+ *           the innermost last. They hide the variables of the table.
+ * @n_overlay: Number of assignments in @overlay.
+ * @overlay_size: Capacity of @overlay.
+ * @base: Number of assignments of the commands the running one is nested
+ *        in, what @n_overlay goes back to once it is done.
+ * @gen: Bumped whenever a value is set or a variable removed, what is
+ *       worked out from the variables is good while it stays the same.
+ */
+
+typedef struct env
+{
+	env_var_t *slots;
+	size_t size;
+	size_t count;
+	char **envp;
+	int stale;
+	char **overlay;
+	size_t n_overlay;
+	size_t overlay_size;
+	size_t base;
+	unsigned long gen;
+} env_t;
+
+int init_env(env_t *env, char **envp);
+env_var_t *env_slot(const env_t *env, const char *name, size_t len,
+					unsigned long hash);
+int set_var(env_t *env, const char *name, size_t len, const char *value,
+			int flags);
+int _setenv(env_t *env, const char *name, const char *value);
+int _unsetenv(env_t *env, const char *name);
+char **env_envp(env_t *env, arena_t *arena);
+void free_env(env_t *env);
+int push_overlay(env_t *env, char *entry);
+char *find_overlay(const env_t *env, const char *name, size_t len);
+char **overlay_envp(const env_t *env, arena_t *arena);
+
 /**
  * struct _path - Structure to build a linked list of directories
  *                in the PATH variable.
@@ -108,112 +294,1268 @@ typedef struct _path
 	struct _path *next;
 } path_t;
 
-void _printenv(void);
+void _printenv(char **envp);
 void print_path(path_t *list);
 void free_list(path_t **head);
-char *_getenv(const char *name);
-path_t *build_path(path_t **head);
+char *_getenv(const env_t *env, const char *name);
+char *find_env(const env_t *env, const char *name, size_t len);
+env_var_t *find_var(const env_t *env, const char *name, size_t len);
+int restore_var(env_t *env, const char *name, const char *value, int flags);
+path_t *build_path(const env_t *env, path_t **head);
+
+#define ALIAS_MIN 64
 
 /**
- * struct alias - Represents the structure for the built-in alias command.
- * @name: Name of the alias.
- * @value: Value assigned to the alias name.
- * @next: Pointer to the next alias_t node.
+ * struct alias - An alias, a slot of the alias table.
+ * @name: Name of the alias, interned, NULL for a free slot.
+ * @value: Value assigned to the alias name, as it was given.
+ * @text: A copy of the value, split into words in place.
+ * @words: The words of the value, unquoted, NULL if it cannot be split.
+ * @n_words: Number of words.
+ * @compound: Set when the value has operators, it then runs as a command
+ *            line of its own, the arguments after it, instead of being
+ *            split.
+ * @running: Set while the value of a compound alias runs, the alias is not
+ *           expanded again in it.
+ * @resolved: The words the alias expands to: those of the value, the
+ *            first one replaced by those of the alias it names, and so on.
+ *            NULL until the alias is used.
+ * @n_resolved: Number of words in @resolved.
+ * @gen: The generation of the table @resolved was made in.
+ * @mark: Set while the chain of the alias being resolved goes through it.
+ * @link: The alias before it in that chain.
+ * @hash: Hash of the name.
  */
 
 typedef struct alias
 {
-	char *name;
+	const char *name;
 	char *value;
-	struct alias *next;
+	char *text;
+	char **words;
+	size_t n_words;
+	int compound;
+	int running;
+	char **resolved;
+	size_t n_resolved;
+	unsigned long gen;
+	unsigned long mark;
+	struct alias *link;
+	unsigned long hash;
 } alias_t;
 
-void free_aliases(alias_t **aliases);
-void print_aliases(const alias_t *aliases);
-int unalias(alias_t **aliases, char *command);
-char *get_alias(alias_t *aliases, const char *name);
-int handle_alias(alias_t **aliases, char *command_line);
-int print_alias(const alias_t *aliases, const char *name);
-void parse_aliases(const char *input, alias_t **aliases);
-void build_alias_cmd(char ***sub_command, char *alias_value);
-alias_t *add_alias(alias_t **aliases, const char *name, const char *value);
-void process_non_matching(alias_t *aliases, const char *non_matching, int end);
+/**
+ * struct alias_table - The aliases, in an open addressing hash table.
+ * @slots: The slots, a power of 2 of them.
+ * @size: Number of slots.
+ * @count: Number of aliases.
+ * @gen: Bumped whenever an alias is defined or removed, the resolved words
+ *       made before are out of date.
+ * @marks: Number of chains resolved, to mark the aliases of each apart.
+ */
 
+typedef struct alias_table
+{
+	alias_t *slots;
+	size_t size;
+	size_t count;
+	unsigned long gen;
+	unsigned long marks;
+} alias_table_t;
+
+alias_t *add_alias(alias_table_t *table, const char *name, const char *value,
+				   const char *words, size_t n_words);
+alias_t *alias_slot(const alias_table_t *table, const char *name,
+					unsigned long hash);
+alias_t *find_alias(const alias_table_t *table, const char *name);
+int remove_alias(alias_table_t *table, const char *name);
+void free_aliases(alias_table_t *table);
+void print_aliases(const alias_table_t *table);
+int unalias(alias_table_t *table, char **names);
+int handle_alias(alias_table_t *table, char *command_line);
+int print_alias(const alias_table_t *table, const char *name);
+int parse_aliases(alias_table_t *table, char **args);
+
+
+/* lexer - token types and word flags */
+
+#define TOK_EOF 0
+#define TOK_WORD 1
+#define TOK_NEWLINE 2
+#define TOK_SEMI 3
+#define TOK_AND_IF 4
+#define TOK_OR_IF 5
+#define TOK_PIPE 6
+#define TOK_LPAREN 7
+#define TOK_RPAREN 8
+#define TOK_DSEMI 9
+#define TOK_ARITH 10 /* ((expression)), the token is the expression */
+
+#define W_QUOTED 1	/* the word contains quotes to remove */
+#define W_ESCAPED 2 /* the word contains backslash escapes to remove */
+#define W_DOLLAR 4	/* the word contains a '$' outside single quotes */
+#define W_GLOB 8	/* the word contains an unquoted '*', '?' or '[' */
+#define W_BRACE 16 /* the word contains an unquoted '{', maybe to expand */
+
+/**
+ * struct token - A token found by the lexer.
+ * @type: The kind of token (TOK_*).
+ * @flags: For words, what has to be done to the word before use (W_*).
+ * @start: Start of the token in the scanned line.
+ * @len: Length of the token in bytes.
+ */
+
+typedef struct token
+{
+	int type;
+	int flags;
+	char *start;
+	size_t len;
+} token_t;
+
+/* the bytes find_meta() stops at */
+
+#define META_WORD 0	  /* what ends a word or needs a flag */
+#define META_DQUOTE 1 /* '"', '$' and '\\', between double quotes */
+#define META_SQUOTE 2 /* the closing single quote */
+#define META_LINE 3	  /* the end of the line, in comments */
+#define N_META 4
+
+/**
+ * struct lexer - The tokens of a line.
+ * @tokens: The tokens, the array is kept from line to line and only grown.
+ * @count: Number of tokens in the array.
+ * @size: Capacity of the array.
+ * @error: Description of the last syntax error, NULL if there was none.
+ */
+
+typedef struct lexer
+{
+	token_t *tokens;
+	size_t count;
+	size_t size;
+	const char *error;
+} lexer_t;
+
+int lex_line(lexer_t *lx, char *line);
+char *token_word(token_t *tok);
+size_t unquote_word(char *word, size_t len);
+char *find_meta(const char *p, int set);
+char *skip_arith(const char *p);
+void free_lexer(lexer_t *lx);
+
+/* brace expansion - "{a,b}" and "{1..10}", done on the words as written */
+
+#define BRACE_NUM_SIZE 32 /* room for a value of a sequence, padding apart */
+
+/**
+ * struct brace_range - The values of a sequence, "{1..10}" or "{a..z..2}".
+ * @first: The first value, the code of a letter for letters.
+ * @step: What each value adds to the previous one, negative going down.
+ * @count: Number of values.
+ * @width: Width numbers are padded to with zeros, 0 if they are not.
+ * @letters: Set when the values are letters.
+ */
+
+typedef struct brace_range
+{
+	intmax_t first;
+	intmax_t step;
+	uintmax_t count;
+	size_t width;
+	int letters;
+} brace_range_t;
+
+/**
+ * struct brace_out - The words a brace expansion made.
+ * @buf: The words, one after the other, each NUL-terminated.
+ * @len: Length of @buf.
+ * @size: Capacity of @buf.
+ * @count: Number of words.
+ */
+
+typedef struct brace_out
+{
+	char *buf;
+	size_t len;
+	size_t size;
+	size_t count;
+} brace_out_t;
+
+const char *brace_skip(const char *p, const char *end);
+int brace_group(const char *text, size_t len, size_t from, size_t *open,
+				size_t *close, brace_range_t *range);
+size_t brace_value(const brace_range_t *range, uintmax_t k, char *buf);
+int brace_expand(brace_out_t *out, const char *text, size_t len,
+				 size_t from);
+
+/* parser - syntax tree node types and flags */
+
+#define N_LIST 1	 /* and-or lists separated by ';' or newlines */
+#define N_AND_OR 2	 /* pipelines joined by '&&' or '||' */
+#define N_PIPELINE 3 /* commands joined by '|' */
+#define N_COMMAND 4	 /* a simple command */
+#define N_IF 5		 /* if: condition, then part, else part (list or N_IF) */
+#define N_WHILE 6	 /* while or until: condition, body */
+#define N_FOR 7		 /* for: body, items (N_COMMAND, may be NULL), words: name */
+#define N_GROUP 8	 /* { list; } */
+#define N_FUNCTION 9 /* function definition: body, words: name */
+#define N_CASE 10	 /* case: arms (N_ARM), words: the word to match */
+#define N_ARM 11	 /* case arm: list (may be NULL), words: patterns, '|' apart */
+#define N_ARITH 12	 /* ((expression)), words: the expression */
+
+#define NF_BANG 1 /* pipeline: negate its exit status ('!') */
+#define NF_AND 2  /* pipeline: the next one only runs if this one succeeds */
+#define NF_OR 4	  /* pipeline: the next one only runs if this one fails */
+#define NF_UNTIL 8 /* while: loop until the condition succeeds */
+
+/* reserved words, only recognized unquoted where a command starts */
+
+#define R_NONE 0
+#define R_IF 1
+#define R_THEN 2
+#define R_ELSE 3
+#define R_ELIF 4
+#define R_FI 5
+#define R_WHILE 6
+#define R_UNTIL 7
+#define R_FOR 8
+#define R_IN 9
+#define R_DO 10
+#define R_DONE 11
+#define R_LBRACE 12
+#define R_RBRACE 13
+#define R_CASE 14
+#define R_ESAC 15
+
+#define starts_compound(w) ((w) == R_IF || (w) == R_WHILE || (w) == R_UNTIL || \
+							(w) == R_FOR || (w) == R_LBRACE || (w) == R_CASE)
+
+#define NODE_CHUNK 128
+
+/**
+ * struct node - A node of the syntax tree.
+ * @type: The kind of node (N_*).
+ * @flags: Node specific flags (NF_*).
+ * @words: For simple commands, the word tokens of the command.
+ * @n_words: For simple commands, the number of words.
+ * @child: The first node of each sub-list. Lists, and-or lists and pipelines
+ *         keep their elements in @child[0], chained through @next.
+ * @next: The next node of the list this node belongs to.
+ */
+
+typedef struct node
+{
+	int type;
+	int flags;
+	token_t *words;
+	size_t n_words;
+	struct node *child[3];
+	struct node *next;
+} node_t;
+
+/**
+ * struct node_chunk - A block of syntax tree nodes.
+ * @next: The next block.
+ * @used: Number of nodes handed out from this block.
+ * @nodes: The nodes.
+ */
+
+typedef struct node_chunk
+{
+	struct node_chunk *next;
+	size_t used;
+	node_t nodes[NODE_CHUNK];
+} node_chunk_t;
+
+/**
+ * struct parser - State of the parser.
+ * @tok: The next token to parse.
+ * @chunks: The blocks nodes are taken from, kept from line to line.
+ * @current: The block nodes are currently taken from.
+ * @bad: The token a syntax error was found at, NULL if there was none.
+ */
+
+typedef struct parser
+{
+	token_t *tok;
+	node_chunk_t *chunks;
+	node_chunk_t *current;
+	token_t *bad;
+} parser_t;
+
+node_t *parse_program(parser_t *p, token_t *tokens, int complete);
+node_t *parse_and_or(parser_t *p);
+node_t *parse_compound(parser_t *p, int word);
+node_t *parse_compound_list(parser_t *p);
+node_t *parse_group(parser_t *p);
+node_t *parse_function(parser_t *p);
+node_t *parse_case(parser_t *p);
+int reserved_word(const token_t *tok);
+int accept_word(parser_t *p, int word);
+int is_name(const char *word, size_t len);
+node_t *new_node(parser_t *p, int type);
+int skip_newlines(parser_t *p);
+void reset_parser(parser_t *p);
+void free_parser(parser_t *p);
+
+/* bytecode - instructions (a, b are operands, targets are code indexes) */
+
+#define OP_HALT 0	   /* stop, the end of the program */
+#define OP_ARGV 1	   /* a: first word, b: count; builds the arguments */
+#define OP_EXPAND 2	   /* as OP_ARGV, expanding the words flagged WORD_RAW */
+#define OP_EXEC 3	   /* runs the arguments: alias, builtin or program */
+#define OP_BUILTIN 4   /* a: builtin; run unless a function or alias hides it */
+#define OP_ALIAS 5	   /* a: offset of the command's text; alias builtins */
+#define OP_JMP 6	   /* a: target */
+#define OP_JZ 7		   /* a: target, taken if the exit code is 0 */
+#define OP_JNZ 8	   /* a: target, taken if the exit code is not 0 */
+#define OP_NOT 9	   /* negates the exit code */
+#define OP_PIPE 10	   /* a: end of the pipeline, its first stage follows */
+#define OP_STAGE 11	   /* a: next stage or pipeline end, b: 1 if simple command */
+#define OP_STAGE_END 12 /* ends the command of a stage */
+#define OP_SET 13	   /* a: value; sets the exit code */
+#define OP_LOOP 14	   /* starts a loop, a: 1 over the args, 2 over sequence b */
+#define OP_SAVE 15	   /* keeps the exit code of the loop's body */
+#define OP_ENDLOOP 16  /* ends a loop, the exit code becomes the body's */
+#define OP_BREAK 17	   /* a: target, b: loops to end; exit code set to 0 */
+#define OP_NEXT 18	   /* a: target when done, b: offset of the variable name */
+#define OP_DEFUN 19	   /* a: end of the body, which follows, b: offset of name */
+#define OP_PARAMS 20   /* builds the arguments from the positional parameters */
+#define OP_CASE 21	   /* a: hash slots, b: patterns; the arms' table follows */
+#define OP_ARM 22	   /* table: a: literal pattern or -1, b: target */
+#define OP_GLOB 23	   /* table: a: wildcard pattern, b: target */
+#define OP_GLOBVAR 24  /* table: a: pattern to expand first, b: target */
+#define OP_ARITH 25	   /* a: offset of an expression; evaluates it */
+#define OP_ASSIGN 26   /* a: first word, b: count; sets the variables */
+#define OP_OVERLAY 27  /* as OP_ASSIGN, for the command that follows only */
+
+/**
+ * struct insn - A bytecode instruction.
+ * @op: The operation (OP_*).
+ * @a: First operand.
+ * @b: Second operand.
+ */
+
+typedef struct insn
+{
+	int32_t op;
+	int32_t a;
+	int32_t b;
+} insn_t;
+
+/**
+ * struct program - A compiled program. It holds no pointers, so it can be
+ * saved and mapped back as it is.
+ * @code: The instructions.
+ * @n_code: Number of instructions.
+ * @code_size: Capacity of @code.
+ * @words: The arguments of the commands, as offsets into @strings. Words
+ *         with parameters or wildcards are flagged WORD_RAW.
+ * @n_words: Number of words.
+ * @words_size: Capacity of @words.
+ * @strings: The words, NUL-terminated, one after the other. They are
+ *           unquoted, except the WORD_RAW ones, kept as they were written.
+ * @strings_len: Length of @strings.
+ * @strings_size: Capacity of @strings.
+ * @oom: Set when memory ran out while compiling.
+ * @refs: Number of functions defined by the program, and of their calls
+ *        that are running.
+ * @names: The names of the commands that have run, interned, at the index
+ *         of their first word, NULL elsewhere. Made as they run, not saved.
+ * @next: The next program kept alive by the shell.
+ */
+
+typedef struct program
+{
+	insn_t *code;
+	size_t n_code;
+	size_t code_size;
+	uint32_t *words;
+	size_t n_words;
+	size_t words_size;
+	char *strings;
+	size_t strings_len;
+	size_t strings_size;
+	int oom;
+	int refs;
+	const char **names;
+	struct program *next;
+} program_t;
+
+#define WORD_RAW 0x80000000U  /* the word is expanded when the command runs */
+#define WORD_GLOB 0x40000000U /* the fields of the expanded word are globbed */
+#define WORD_OFFSET(w) ((w) & ~(WORD_RAW | WORD_GLOB))
+
+/**
+ * struct loop_ctx - A loop being compiled.
+ * @breaks: Chain of the OP_BREAK instructions leaving the loop.
+ * @continues: Chain of the OP_BREAK instructions continuing the loop.
+ * @outer: The enclosing loop, NULL if there is none.
+ */
+
+typedef struct loop_ctx
+{
+	int32_t breaks;
+	int32_t continues;
+	struct loop_ctx *outer;
+} loop_ctx_t;
+
+/**
+ * struct compiler - State of the compiler.
+ * @prog: The program being compiled.
+ * @loop: The innermost loop being compiled, NULL outside loops.
+ */
+
+typedef struct compiler
+{
+	program_t *prog;
+	loop_ctx_t *loop;
+} compiler_t;
+
+/**
+ * struct brace_iter - The words a for loop over a sequence goes over, made
+ * one at a time.
+ * @word: The word, as written.
+ * @open: Index of the '{' of the sequence in @word.
+ * @close: Index of its '}'.
+ * @range: The values of the sequence.
+ * @index: Index of the next value.
+ * @buf: Where each word is made, the value between the parts of @word.
+ */
+
+typedef struct brace_iter
+{
+	const char *word;
+	size_t open;
+	size_t close;
+	brace_range_t range;
+	uintmax_t index;
+	char *buf;
+} brace_iter_t;
+
+int brace_sequence(const char *word, size_t len, size_t *open, size_t *close,
+				   brace_range_t *range);
+brace_iter_t *new_brace_iter(arena_t *arena, const char *word);
+const char *brace_next(brace_iter_t *it);
+
+/**
+ * struct loop_frame - A running loop.
+ * @status: Exit code of the last run of the body, 0 before it ran.
+ * @items: For 'for' loops, the words iterated over.
+ * @index: For 'for' loops, the next word.
+ * @seq: For 'for' loops over a sequence, the words, NULL for the others.
+ * @floor: The arena in use once the loop started, commands of the body
+ *         give back what they use down to there.
+ */
+
+typedef struct loop_frame
+{
+	int status;
+	char **items;
+	size_t index;
+	brace_iter_t *seq;
+	arena_mark_t floor;
+} loop_frame_t;
+
+/**
+ * struct vm_stack - The running loops, shared by the nested vm_run() calls.
+ * @frames: The loops, innermost last, kept from command to command.
+ * @count: Number of running loops.
+ * @size: Capacity of @frames.
+ */
+
+typedef struct vm_stack
+{
+	loop_frame_t *frames;
+	size_t count;
+	size_t size;
+} vm_stack_t;
+
+int compile_program(program_t *prog, node_t *list);
+void compile_list(compiler_t *c, node_t *list);
+void compile_and_or(compiler_t *c, node_t *and_or);
+void compile_args(compiler_t *c, node_t *cmd, uint32_t glob);
+size_t count_assigns(const node_t *cmd);
+void compile_assigns(compiler_t *c, node_t *cmd, size_t n, int32_t op);
+void compile_compound(compiler_t *c, node_t *node);
+void compile_while(compiler_t *c, node_t *node);
+void compile_for(compiler_t *c, node_t *node);
+void compile_case(compiler_t *c, node_t *node);
+int compile_break(compiler_t *c, node_t *cmd);
+void patch_jumps(program_t *prog, int32_t chain, int32_t target);
+int32_t emit(program_t *prog, int op, int32_t a, int32_t b);
+int32_t add_string(program_t *prog, const char *str, size_t len);
+int grow_buffer(program_t *prog, void **buf, size_t count, size_t *size,
+				size_t elem);
+void reset_program(program_t *prog);
+void free_program(program_t *prog);
+char **copy_items(arena_t *arena, char **argv);
+
+/* script cache - compiled scripts saved to disk (opt-in, see HSH_CACHE_DIR) */
+
+#define CACHE_MAGIC "HSHC"
+#define CACHE_VERSION 12 /* bump when the bytecode or the builtins change */
+
+/**
+ * struct cache_header - Header of a cache file, the program follows: its
+ * code, its words and its strings.
+ * @magic: CACHE_MAGIC.
+ * @version: CACHE_VERSION, files of other versions are ignored.
+ * @dev: Device of the script.
+ * @ino: Inode of the script.
+ * @size: Size of the script.
+ * @mtime_sec: Modification time of the script, seconds.
+ * @mtime_nsec: Modification time of the script, nanoseconds.
+ * @n_code: Number of instructions.
+ * @n_words: Number of words.
+ * @strings_len: Length of the strings.
+ */
+
+typedef struct cache_header
+{
+	char magic[4];
+	uint32_t version;
+	uint64_t dev;
+	uint64_t ino;
+	uint64_t size;
+	int64_t mtime_sec;
+	int64_t mtime_nsec;
+	uint32_t n_code;
+	uint32_t n_words;
+	uint64_t strings_len;
+} cache_header_t;
+
+/**
+ * struct script_cache - The cache entry of the script being run.
+ * @path: The cache file of the script, NULL when caching is off.
+ * @key: The script's status, its identity in the cache.
+ * @map: The mapped cache file, NULL if the script was not loaded from it.
+ * @map_size: Size of the mapping.
+ */
+
+typedef struct script_cache
+{
+	char *path;
+	struct stat key;
+	void *map;
+	size_t map_size;
+} script_cache_t;
+
+/* snapshots - the state of a shell saved to disk, see the snapshot builtin */
+
+#define SNAP_MAGIC "HSHS"
+
+/**
+ * struct snap_header - Header of a snapshot file. The records follow, then
+ * the sizes of the programs, then the programs, each its code, its words
+ * and its strings padded to 8 bytes, then the strings of the records.
+ * Everything is found by offset, the file is used where it is mapped.
+ * @magic: SNAP_MAGIC.
+ * @version: CACHE_VERSION, the programs are compiled like cached scripts.
+ * @n_vars: Number of variables, the first records.
+ * @n_aliases: Number of aliases, the records after the variables.
+ * @n_functions: Number of functions, the last records.
+ * @n_progs: Number of programs.
+ * @strings_len: Length of the strings of the records.
+ */
+
+typedef struct snap_header
+{
+	char magic[4];
+	uint32_t version;
+	uint32_t n_vars;
+	uint32_t n_aliases;
+	uint32_t n_functions;
+	uint32_t n_progs;
+	uint64_t strings_len;
+} snap_header_t;
+
+/**
+ * struct snap_record - A variable, an alias or a function of a snapshot.
+ * @name: Offset of the name in the strings, of the whole "NAME=value" entry
+ *        for variables.
+ * @value: Length of the name for variables, offset of the value for
+ *         aliases, index of the program holding the body for functions.
+ * @info: The attributes of variables (VAR_*). For aliases, one more than
+ *        the number of words of the value, which follow it in the strings,
+ *        0 if it could not be split. For functions, the first instruction
+ *        of the body.
+ */
+
+typedef struct snap_record
+{
+	uint32_t name;
+	uint32_t value;
+	uint32_t info;
+} snap_record_t;
+
+/**
+ * struct snap_prog - The sizes of a program of a snapshot.
+ * @n_code: Number of instructions.
+ * @n_words: Number of words.
+ * @strings_len: Length of the strings.
+ */
+
+typedef struct snap_prog
+{
+	uint32_t n_code;
+	uint32_t n_words;
+	uint32_t strings_len;
+} snap_prog_t;
+
+/**
+ * struct snap_writer - A snapshot being put together.
+ * @records: The records, room for every variable, alias and function.
+ * @n_records: Number of records so far.
+ * @strings: The strings of the records.
+ * @strings_len: Length of @strings.
+ * @strings_size: Capacity of @strings.
+ * @progs: The programs holding the functions, room for one per function.
+ * @n_progs: Number of programs so far.
+ * @oom: Set when memory ran out.
+ */
+
+typedef struct snap_writer
+{
+	snap_record_t *records;
+	size_t n_records;
+	char *strings;
+	size_t strings_len;
+	size_t strings_size;
+	const program_t **progs;
+	size_t n_progs;
+	int oom;
+} snap_writer_t;
+
+/**
+ * struct snapshot - The snapshot a shell was started from.
+ * @map: The mapped file, the programs of its functions run from it. NULL
+ *       if the shell was not started from a snapshot.
+ * @map_size: Size of the mapping.
+ */
+
+typedef struct snapshot
+{
+	void *map;
+	size_t map_size;
+} snapshot_t;
+
+/* the escapes of a PS1 template */
+#define PS_TEXT 0 /* text of the template */
+#define PS_USER 1 /* \u, $USER */
+#define PS_HOST 2 /* \h, the host name up to the first '.' */
+#define PS_CWD 3  /* \w, $PWD with $HOME shown as ~ */
+#define PS_DIR 4  /* \W, the last component of $PWD, ~ in $HOME */
+#define PS_SIGN 5 /* \$, # for root, else $ */
+
+#define DEFAULT_PS1 "[\\u@\\h \\W]% "
+#define PLAIN_PS1 "hsh% " /* when PS1 and USER are not set */
+
+/**
+ * struct prompt_part - A piece of the prompt.
+ * @type: PS_TEXT for text of the template, else the escape it stands for.
+ * @start: Where the text starts in the text of the prompt.
+ * @len: Length of the text.
+ */
+
+typedef struct prompt_part
+{
+	int type;
+	size_t start;
+	size_t len;
+} prompt_part_t;
+
+/**
+ * struct prompt - The prompt of an interactive shell, compiled from PS1.
+ * @ps1: The template @parts were compiled from, NULL until the first one.
+ * @text: The text of the template, escapes taken out.
+ * @parts: The pieces of the prompt, in order.
+ * @n_parts: Number of pieces.
+ * @host: The host name, asked for once.
+ * @out: The prompt as last rendered, NULL until then.
+ * @out_size: Capacity of @out.
+ * @gen: The generation of the variables @out was rendered from.
+ */
+
+typedef struct prompt
+{
+	char *ps1;
+	char *text;
+	prompt_part_t *parts;
+	size_t n_parts;
+	char *host;
+	char *out;
+	size_t out_size;
+	unsigned long gen;
+} prompt_t;
+
+void free_prompt(prompt_t *prompt);
+
+/**
+ * struct command - A command name known to the shell.
+ * @name: The name, interned.
+ * @builtin: The builtin of that name, -1 if there is none.
+ * @prog: The program holding the function of that name, NULL if there is
+ *        none.
+ * @start: The first instruction of the function's body.
+ * @alias: Set if an alias has that name too, as of @alias_gen.
+ * @alias_gen: The generation of the alias table @alias was checked in.
+ */
+
+typedef struct command
+{
+	const char *name;
+	int builtin;
+	program_t *prog;
+	size_t start;
+	int alias;
+	unsigned long alias_gen;
+} command_t;
+
+/**
+ * struct cmd_table - The commands known to the shell, in an open addressing
+ * hash table. Commands are never removed.
+ * @slots: The slots, a free slot has no name.
+ * @size: Number of slots, a power of two.
+ * @count: Number of commands.
+ * @n_functions: Number of commands that are functions.
+ */
+
+typedef struct cmd_table
+{
+	command_t *slots;
+	size_t size;
+	size_t count;
+	size_t n_functions;
+} cmd_table_t;
+
+/**
+ * struct saved_var - A variable made local to a function call.
+ * @name: The variable's name.
+ * @value: Its value before the call, NULL if it had none.
+ * @flags: Its attributes before the call, -1 if it was not set at all.
+ * @next: The next saved variable.
+ */
+
+typedef struct saved_var
+{
+	char *name;
+	char *value;
+	int flags;
+	struct saved_var *next;
+} saved_var_t;
+
+/**
+ * struct call_frame - A running function call.
+ * @args: The positional parameters, the function's name first.
+ * @argc: Number of words in @args.
+ * @locals: The variables to restore when the call returns.
+ * @depth: Number of calls running, this one included.
+ * @prev: The calling function's frame, NULL at the top level.
+ */
+
+typedef struct call_frame
+{
+	char **args;
+	size_t argc;
+	saved_var_t *locals;
+	int depth;
+	struct call_frame *prev;
+} call_frame_t;
+
+#define EXPAND_MIN 256 /* initial size of the expansion buffer */
+
+/* what expand_word() builds */
+#define EXPAND_FIELDS 0	 /* fields, unquoted */
+#define EXPAND_PATTERN 1 /* a pattern of a case, a single field */
+#define EXPAND_GLOB 2	 /* fields to glob, what is quoted in them escaped */
+
+/**
+ * struct dir_list - The names in a directory, listed once per command.
+ * @path: The directory, "" for the current one, else ending with a '/'.
+ * @names: The names, but "." and "..", in the order they were read.
+ * @count: Number of names, 0 if the directory could not be read.
+ * @next: The next directory listed.
+ */
+
+typedef struct dir_list
+{
+	const char *path;
+	char **names;
+	size_t count;
+	struct dir_list *next;
+} dir_list_t;
+
+#define WALK_THREADS 8	  /* threads reading the directories of a "**", at most */
+#define WALK_BUF 32768	  /* bytes of directory entries read at once */
+#define WALK_QUEUE_MIN 64 /* initial capacity of a worker's queue */
+#define WALK_OUT_MIN 4096 /* initial capacity of a worker's results */
+
+struct walker;
+
+/**
+ * struct walk_worker - A thread of the walker of a "**", with its queue of
+ * directories to read and the results it found.
+ * @walker: The walk.
+ * @id: Index of the worker.
+ * @jobs: The directories to read, relative to the root of the walk and
+ *        ending with a '/', "" for the root, each allocated.
+ * @head: Index of the oldest directory, the one the other workers steal.
+ * @tail: Index past the newest directory, the one the worker takes.
+ * @size: Capacity of @jobs.
+ * @lock: Guards @jobs, @head, @tail and @size.
+ * @out: The results, relative to the root of the walk, each NUL-terminated.
+ * @out_len: Length of @out.
+ * @out_size: Capacity of @out.
+ * @thread: The thread, for the workers but the first, run by the shell.
+ * @started: Set once @thread runs.
+ * @failed: Set by the worker when memory ran out, read once it is joined.
+ */
+
+typedef struct walk_worker
+{
+	struct walker *walker;
+	size_t id;
+	char **jobs;
+	size_t head;
+	size_t tail;
+	size_t size;
+	pthread_mutex_t lock;
+	char *out;
+	size_t out_len;
+	size_t out_size;
+	pthread_t thread;
+	int started;
+	int failed;
+} walk_worker_t;
+
+/**
+ * struct walker - A walk of a directory tree by several threads.
+ * @root: The directory the walk starts from, open.
+ * @pattern: The pattern the names found are matched against, NULL to only
+ *           list the directories.
+ * @dot: Set when @pattern starts with a '.', hidden names then match it.
+ * @workers: The workers.
+ * @n_workers: Number of @workers.
+ * @pending: Number of directories queued or being read, the walk is done
+ *           when it drops to 0.
+ * @pushed: Number of directories queued so far, tells an idle worker that
+ *          something was queued since it last looked.
+ * @idle: Number of workers waiting for directories.
+ * @lock: Guards @pending, @pushed and @idle.
+ * @wake: Signaled when directories are queued or the walk is done.
+ */
+
+typedef struct walker
+{
+	int root;
+	const char *pattern;
+	int dot;
+	walk_worker_t *workers;
+	size_t n_workers;
+	size_t pending;
+	unsigned long pushed;
+	size_t idle;
+	pthread_mutex_t lock;
+	pthread_cond_t wake;
+} walker_t;
+
+/**
+ * struct expand - The buffers of the expansions, kept from word to word.
+ * @buf: The fields of the word being expanded, each NUL-terminated.
+ * @len: Length of @buf.
+ * @size: Capacity of @buf.
+ * @start: Where the field being expanded starts in @buf.
+ * @done: Number of fields ended in @buf.
+ * @keep: Set when the field being expanded had quotes, it is then kept
+ *        even if empty.
+ * @pattern: What is being built (EXPAND_*), see expand_word().
+ * @fields: The arguments of the command being expanded.
+ * @n_fields: Number of @fields.
+ * @fields_size: Capacity of @fields.
+ * @dirs: The directories listed by the globs of the command, in the arena.
+ * @path: The path being globbed.
+ * @path_size: Capacity of @path.
+ */
+
+typedef struct expand
+{
+	char *buf;
+	size_t len;
+	size_t size;
+	size_t start;
+	size_t done;
+	int keep;
+	int pattern;
+	char **fields;
+	size_t n_fields;
+	size_t fields_size;
+	dir_list_t *dirs;
+	char *path;
+	size_t path_size;
+} expand_t;
+
+/* arithmetic - expressions are parsed once to code run on a stack */
+
+#define A_NUM 0	   /* pushes @value */
+#define A_VAR 1	   /* pushes the value of the parameter @name */
+#define A_UNARY 2  /* applies @op ('-', '+', '!' or '~') to the top */
+#define A_BINARY 3 /* replaces the two on top by them joined with @op */
+#define A_ASSIGN 4 /* @name = top, or @name @op= top unless @op is '=' */
+#define A_INCR 5   /* adds @value to @name, pushes it, or the old one if @op */
+#define A_AND 6	   /* top is 0: goes on at @jump, else pops it ('&&') */
+#define A_OR 7	   /* top is not 0: makes it 1, goes on at @jump ('||') */
+#define A_JZ 8	   /* pops, goes on at @jump if it was 0 ('?') */
+#define A_JMP 9	   /* goes on at @jump (':') */
+#define A_POP 10   /* drops the top (',') */
+#define A_BOOL 11  /* makes the top 0 or 1 */
+
+/* binary operators written with two characters, the others are their own */
+#define AO_SHL 256
+#define AO_SHR 257
+#define AO_LE 258
+#define AO_GE 259
+#define AO_EQ 260
+#define AO_NE 261
+#define AO_AND 262
+#define AO_OR 263
+
+/* precedence of the operators, from the loosest */
+#define P_COMMA 1
+#define P_ASSIGN 2
+#define P_COND 3
+#define P_OR 4
+#define P_AND 5
+#define P_BOR 6
+#define P_XOR 7
+#define P_BAND 8
+#define P_EQ 9
+#define P_REL 10
+#define P_SHIFT 11
+#define P_ADD 12
+#define P_MUL 13
+
+#define ARITH_DEPTH 64		 /* nesting, and values on the stack, at most */
+#define ARITH_SLOTS 256		 /* slots of the cache of parsed expressions */
+#define ARITH_CACHE_MAX 1024 /* the cache is emptied past that many entries */
+
+/**
+ * struct arith_insn - An instruction of a parsed expression.
+ * @kind: What it does (A_*).
+ * @op: The operator.
+ * @jump: Where the jumps go.
+ * @value: The number, or the increment.
+ * @name: The parameter, interned.
+ */
+
+typedef struct arith_insn
+{
+	int kind;
+	int op;
+	int32_t jump;
+	intmax_t value;
+	const char *name;
+} arith_insn_t;
+
+/**
+ * struct arith_expr - A parsed expression, kept in the cache.
+ * @text: The expression, as it was written (not NUL-terminated).
+ * @len: Length of @text.
+ * @hash: Hash of @text.
+ * @code: The instructions.
+ * @n_code: Number of instructions.
+ * @next: The next expression in the same slot.
+ */
+
+typedef struct arith_expr
+{
+	char *text;
+	size_t len;
+	unsigned long hash;
+	arith_insn_t *code;
+	size_t n_code;
+	struct arith_expr *next;
+} arith_expr_t;
+
+/**
+ * struct arith_parser - The state of the parser of an expression.
+ * @p: The next character to read.
+ * @end: The end of the expression.
+ * @code: The instructions emitted.
+ * @n_code: Number of instructions.
+ * @size: Capacity of @code.
+ * @nesting: Depth of the unary operators and parentheses being parsed.
+ * @stack: Number of values on the stack at this point of the code.
+ * @error: What went wrong, NULL if nothing did.
+ */
+
+typedef struct arith_parser
+{
+	const char *p;
+	const char *end;
+	arith_insn_t *code;
+	size_t n_code;
+	size_t size;
+	int nesting;
+	int stack;
+	const char *error;
+} arith_parser_t;
+
+/**
+ * struct arith_cache - The parsed expressions, looked up by their text.
+ * @slots: Hash table of chains of expressions, ARITH_SLOTS of them.
+ * @count: Number of expressions.
+ */
+
+typedef struct arith_cache
+{
+	arith_expr_t **slots;
+	size_t count;
+} arith_cache_t;
+
+const char *arith_blank(const char *p, const char *end);
+int arith_operator(const char *p, const char *end, int *op, int *len);
+const char *arith_number(const char *p, const char *end, intmax_t *value);
+size_t arith_name(const char *p, const char *end);
+int arith_value(const char *str, intmax_t *value);
+int arith_binary(arith_parser_t *ap, int min);
+int parse_arith(arith_parser_t *ap, const char *text, size_t len);
+int parse_nested(arith_parser_t *ap, const char *p);
+void free_arith(arith_cache_t *cache);
 
 /**
  * struct shell - Structure defining the shell properties.
- * @aliases: A list of aliases.
+ * @aliases: The aliases, looked up by name.
  * @path_list: A list of directories in the PATH.
  * @line: The command string provided by the user.
- * @commands: Initial tokenized commands (split by semi-colons & newlines).
- * @sub_command: Tokenized version of each command in the commands array.
+ * @lexer: The tokens of @line.
+ * @sub_command: The arguments of the command being executed, in @arena. The
+ *               words live in the program or @aliases, the expanded
+ *               ones in @arena.
+ * @cmd_name: The first of them interned, NULL if it was expanded.
+ * @expand: The buffers the words of the commands are expanded in.
+ * @arith: The arithmetic expressions parsed so far.
+ * @arena: Memory for the arguments and what else lives while a command
+ *         runs. It is given back once the command is done.
+ * @loops: The running loops.
+ * @parser: The parser and the syntax tree of @line.
+ * @program: The compiled @line, its buffers are kept from line to line
+ *           unless it defined functions.
+ * @programs: The programs allocated by the shell and still alive.
+ * @commands: The builtins and functions, looked up by name.
+ * @call: The innermost running function call, NULL outside functions.
+ * @returning: Set by the return builtin until the function has returned.
+ * @subshell: Non-zero in a forked child that exits once its command is done.
+ * @repl: Non-zero while commands are read from the standard input, a
+ *        command may then go on over several lines.
+ * @interactive: Non-zero if the standard input was a terminal when the
+ *               shell started, only then are prompts shown.
+ * @prompt: The prompt shown before each line in interactive mode.
+ * @cache: The cache entry of the script being run.
+ * @snapshot: The snapshot the shell was started from.
+ * @env: The variables, those exported are the environment of children.
  * @prog_name: The name of the shell program.
+ * @pid: The shell's process ID, "$$", the same in its children.
  * @cmd_count: Number of times a command has been executed since shell start.
- * @tokens: Stores multiple tokens before further processing.
- * @token: A single token.
  * @exit_code: Exit code of the last executed program.
  */
 
 typedef struct shell
 {
-	alias_t *aliases;
+	alias_table_t aliases;
 	path_t *path_list;
 	char *line;
-	char **commands;
+	lexer_t lexer;
 	char **sub_command;
-	char **tokens;
-	char *token;
+	const char *cmd_name;
+	expand_t expand;
+	arith_cache_t arith;
+	arena_t arena;
+	vm_stack_t loops;
+	parser_t parser;
+	program_t *program;
+	program_t *programs;
+	cmd_table_t commands;
+	call_frame_t *call;
+	int returning;
+	int subshell;
+	int repl;
+	int interactive;
+	prompt_t prompt;
+	script_cache_t cache;
+	snapshot_t snapshot;
+	env_t env;
 	const char *prog_name;
+	pid_t pid;
 	size_t cmd_count;
 	int exit_code;
 } shell_t;
 
 shell_t *init_shell(void);
+void load_rc(shell_t *hsh);
+void show_prompt(shell_t *hsh);
+int expand_alias(shell_t *hsh, alias_t *alias);
+int run_alias(shell_t *hsh, alias_t *alias);
 void sigint_handler(int signum);
 
+#define N_BUILTINS 14
+
+/**
+ * struct builtin - A builtin command.
+ * @name: The command name.
+ * @run: Runs the builtin with the arguments of the current command.
+ */
+
+typedef struct builtin
+{
+	const char *name;
+	int (*run)(shell_t *hsh);
+} builtin_t;
+
 /**
  * struct builtin_handlers - Collection of functions for handling built-in commands.
- * @unsetenv: Unset an environment variable.
  * @handle_cd: Change directory.
- * @_setenv: Set an environment variable.
- * @handle_builtin: Execute built-in commands.
  * @handle_exit: Handle exit command.
+ * @find_builtin: Look a builtin up by name.
+ * @run_builtin: Run a builtin found by find_builtin.
+ * @builtin_env: The env and printenv builtins.
+ * @builtin_exit: The exit builtin.
+ * @builtin_setenv: The setenv builtin.
+ * @builtin_unsetenv: The unsetenv builtin.
+ * @builtin_break: The break and continue builtins, outside of loops.
+ * @builtin_return: The return builtin.
+ * @builtin_local: The local builtin.
+ * @builtin_export: The export builtin.
+ * @builtin_readonly: The readonly builtin.
+ * @builtin_unset: The unset builtin.
+ * @builtin_snapshot: The snapshot builtin.
+ * @assign_var: Set a shell variable, reporting errors.
+ * @run_assign: Run the assignments of a command.
+ * @init_commands: Fill the command table with the builtins.
  */
 
-int _unsetenv(const char *name);
 int handle_cd(shell_t *hsh);
-int _setenv(const char *name, const char *value, int overwrite);
-int handle_builtin(shell_t *hsh);
+int find_builtin(const char *name);
+int init_commands(cmd_table_t *table);
+int run_builtin(shell_t *hsh, int id);
+int builtin_env(shell_t *hsh);
+int builtin_exit(shell_t *hsh);
+int builtin_setenv(shell_t *hsh);
+int builtin_unsetenv(shell_t *hsh);
+int builtin_break(shell_t *hsh);
+int builtin_return(shell_t *hsh);
+int builtin_local(shell_t *hsh);
+int builtin_export(shell_t *hsh);
+int builtin_readonly(shell_t *hsh);
+int builtin_unset(shell_t *hsh);
+int builtin_snapshot(shell_t *hsh);
+int assign_var(shell_t *hsh, const char *name, size_t len, const char *value,
+			   int flags);
+int run_assign(shell_t *hsh, const program_t *prog, const insn_t *in);
 int handle_exit(shell_t *hsh, void (*cleanup)(const char *format, ...));
 
 /* parsers and executors */
 /**
  * struct parsers_executors - Functions for parsing and executing commands.
- * @get_operator: Retrieve the operator in a command line.
- * @handle_comments: Handle comments in a command line.
- * @parse_line: Parse a command line into separate commands.
+ * @parse_line: Lex a command line and execute it.
  * @execute_command: Execute a command with provided pathname.
- * @parse_and_execute: Parse and execute commands at a specified index.
  * @handle_with_path: Handle command execution with PATH directories.
  * @print_cmd_not_found: Print command not found error message.
  * @handle_file_as_input: Handle file input for command execution.
- * @handle_variables: Handle environment variable substitutions.
- * @parse: Main parsing function for commands.
- * @parse_helper: Helper function for parsing commands at an index.
+ * @expand_word: Expand the parameters of a word and remove its quotes.
+ * @expand_args: Build the arguments of a command, expanding its words.
+ * @expand_pattern: Expand a pattern of a case.
+ * @get_param: Find the value of a parameter.
+ * @scan_param: Find the parameter following a '$'.
+ * @push_fields: Add fields to the arguments being built.
+ * @has_glob: Tell whether an expanded field is a pattern.
+ * @glob_field: Replace a field with the pathnames it matches.
+ * @glob_path: Add the pathnames matching the components of a pattern.
+ * @glob_tree: Add the pathnames a "**" component leads to.
+ * @walk_run: Run a worker of the walker of a "**".
+ * @find_dir: List a directory, once per command.
+ * @path_append: Append a name to the path being globbed.
+ * @find_arith: Find the parsed form of an arithmetic expression.
+ * @arith_error: Report an error in an arithmetic expression.
+ * @arith_eval: Evaluate an arithmetic expression.
+ * @free_expand: Release the expansion buffers.
+ * @parse_helper: Run the alias, builtin or program a command refers to.
+ * @vm_run: Execute a compiled program.
+ * @run_loop_op: Execute a loop instruction.
+ * @pop_loops: End running loops.
+ * @print_syntax_error: Report the syntax error found in a line.
+ * @run_case: Choose the arm of a case command.
+ * @glob_match: Match a string against a wildcard pattern.
+ * @hash_text: Hash a text, the shell's one hash (FNV-1a).
+ * @hash_name: Hash a name, as hash_text() does.
+ * @find_command: Look a builtin or function up by name.
+ * @lookup_command: Look a builtin or function up by interned name.
+ * @resolve_command: Look the command being run up, with its alias.
+ * @command_name: Intern the name of a command of a program.
+ * @add_command: Add a command name to the command table.
+ * @define_function: Define a function.
+ * @call_function: Run a function with the arguments of the current command.
+ * @new_program: Allocate a program kept alive by the shell.
+ * @release_program: Drop a reference to a program.
+ * @free_commands: Release the command table and the programs.
  */
 
-char *get_operator(char *str);
-char *handle_comments(char *command);
 int parse_line(shell_t *hsh);
 int execute_command(const char *pathname, shell_t *hsh);
-int parse_and_execute(shell_t *hsh, size_t index);
 int handle_with_path(shell_t *hsh);
 int print_cmd_not_found(shell_t *hsh);
 void handle_file_as_input(const char *filename, shell_t *hsh);
-char **handle_variables(shell_t *hsh);
-int parse(shell_t *hsh);
-void parse_helper(shell_t *hsh, size_t index);
-char *handle_comments(char *line);
+int expand_word(shell_t *hsh, const char *word, int pattern);
+char **expand_args(shell_t *hsh, const program_t *prog, const insn_t *in);
+const char *expand_pattern(shell_t *hsh, const char *word);
+const char *get_param(shell_t *hsh, const char *name, size_t len, char *num);
+const char *scan_param(const char *p, const char **name, size_t *len);
+int push_fields(expand_t *x, char *fields, size_t n);
+int has_glob(const char *field);
+int glob_field(shell_t *hsh, char *field);
+int glob_path(shell_t *hsh, char *pat, size_t len);
+int glob_tree(shell_t *hsh, char *rest, size_t len);
+void *walk_run(void *arg);
+dir_list_t *find_dir(shell_t *hsh);
+int path_append(expand_t *x, size_t *len, const char *name, int unescape);
+arith_expr_t *find_arith(shell_t *hsh, const char *text, size_t len);
+void arith_error(shell_t *hsh, const char *what, const char *text,
+				 size_t len);
+int arith_eval(shell_t *hsh, const char *text, size_t len, intmax_t *value);
+void free_expand(expand_t *x);
+void parse_helper(shell_t *hsh, char *alias_cmd);
+int vm_run(shell_t *hsh, program_t *prog, size_t pc);
+void run_loop_op(shell_t *hsh, const program_t *prog, const insn_t *in,
+				 vm_stack_t *stack, size_t *pc);
+void pop_loops(vm_stack_t *stack, size_t n);
+arena_mark_t loop_floor(const vm_stack_t *stack, size_t depth,
+						arena_mark_t base);
+size_t run_case(shell_t *hsh, const program_t *prog, size_t pc);
+int glob_match(const char *pattern, const char *str);
+void print_syntax_error(shell_t *hsh);
+int open_script_cache(shell_t *hsh, const char *filename, int fd,
+					  program_t *prog);
+int save_script_cache(shell_t *hsh, const program_t *prog);
+void free_script_cache(script_cache_t *cache);
+int check_program(const program_t *prog);
+int write_all(int fd, const void *data, size_t size);
+int save_snapshot(shell_t *hsh, const char *path);
+int load_snapshot(shell_t *hsh, const char *path);
+void free_snapshot(snapshot_t *snap);
+unsigned long hash_text(const char *text, size_t len);
+unsigned long hash_name(const char *name);
+command_t *find_command(const cmd_table_t *table, const char *name);
+command_t *lookup_command(const cmd_table_t *table, const char *name);
+command_t *resolve_command(shell_t *hsh);
+const char *command_name(program_t *prog, const insn_t *in);
+command_t *add_command(cmd_table_t *table, const char *name);
+int define_function(shell_t *hsh, const char *name, program_t *prog,
+					size_t start);
+int call_function(shell_t *hsh, command_t *cmd);
+program_t *new_program(shell_t *hsh);
+void release_program(shell_t *hsh, program_t *prog);
+void free_commands(shell_t *hsh);
 
 
 #endif /* SHELL_H */
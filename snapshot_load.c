@@ -0,0 +1,214 @@
+#include "shell.h"
+
+/**
+ * map_programs - sets up the programs of a mapped snapshot
+ * @hsh: contains all the data relevant to the shell's operation
+ * @progs: where to store the programs, room for all of them
+ *
+ * Description: The programs run from the mapping, as cached scripts do,
+ * each is checked before it is used. They are kept alive by the shell like
+ * the programs it compiles, their buffers are left alone when freed.
+ *
+ * Return: the strings of the records, NULL if the file is not whole or a
+ * program is not sound
+ */
+static const char *map_programs(shell_t *hsh, program_t **progs)
+{
+	snap_header_t *hdr = hsh->snapshot.map;
+	char *p = (char *)(hdr + 1);
+	char *end = (char *)hdr + hsh->snapshot.map_size;
+	size_t i, len, n = hdr->n_vars + hdr->n_aliases + hdr->n_functions;
+	snap_prog_t *sizes;
+	program_t *prog;
+
+	len = n * sizeof(snap_record_t) + hdr->n_progs * sizeof(snap_prog_t);
+	if (len > (size_t)(end - p))
+		return (NULL);
+	sizes = (snap_prog_t *)(p + n * sizeof(snap_record_t));
+	for (p = (char *)(sizes + hdr->n_progs), i = 0; i < hdr->n_progs; i++)
+	{
+		len = sizes[i].n_code * sizeof(insn_t) +
+			sizes[i].n_words * sizeof(uint32_t) +
+			sizes[i].strings_len + (-sizes[i].strings_len & 7);
+		if (sizes[i].n_code == 0 || sizes[i].strings_len == 0 ||
+			len > (size_t)(end - p))
+			return (NULL);
+		progs[i] = new_program(hsh);
+		if (progs[i] == NULL)
+			return (NULL);
+		prog = progs[i];
+		prog->code = (insn_t *)p;
+		prog->n_code = sizes[i].n_code;
+		prog->words = (uint32_t *)(prog->code + sizes[i].n_code);
+		prog->n_words = sizes[i].n_words;
+		prog->strings = (char *)(prog->words + sizes[i].n_words);
+		prog->strings_len = sizes[i].strings_len;
+		if (!check_program(prog))
+			return (NULL);
+		p += len;
+	}
+	if ((size_t)(end - p) != hdr->strings_len || end == p ||
+		end[-1] != '\0')
+		return (NULL);
+
+	return (p);
+}
+
+/**
+ * check_records - checks the records of a mapped snapshot
+ * @hdr: the header of the snapshot
+ * @progs: its programs, checked
+ * @strings: the strings of the records, the last one terminated
+ *
+ * Return: 1 if the records can be used, 0 otherwise
+ */
+static int check_records(const snap_header_t *hdr, program_t **progs,
+						 const char *strings)
+{
+	const snap_record_t *rec = (const snap_record_t *)(hdr + 1);
+	size_t i, k, at, n_names = hdr->n_vars + hdr->n_aliases;
+
+	for (i = 0; i < n_names + hdr->n_functions; i++, rec++)
+	{
+		if (rec->name >= hdr->strings_len)
+			return (0);
+		if (i >= hdr->n_vars && i < n_names)
+		{
+			/* the value of an alias, then its words */
+			at = rec->value;
+			for (k = 0; k == 0 || k < rec->info; k++)
+			{
+				if (at >= hdr->strings_len)
+					return (0);
+				at += _strlen(strings + at) + 1;
+			}
+		}
+		if (i < hdr->n_vars &&
+			(rec->value >= hdr->strings_len - rec->name ||
+			 strings[rec->name + rec->value] != '=' ||
+			 !is_name(strings + rec->name, rec->value)))
+			return (0);
+		if (i >= n_names && (rec->value >= hdr->n_progs ||
+				rec->info >= progs[rec->value]->n_code))
+			return (0);
+	}
+
+	return (1);
+}
+
+/**
+ * load_records - sets the variables, aliases and functions of a snapshot
+ * @hsh: contains all the data relevant to the shell's operation
+ * @progs: the programs of the snapshot
+ * @strings: the strings of its records
+ *
+ * Description: The exported variables the shell was started with keep the
+ * values it was given, only their attributes are taken from the snapshot.
+ *
+ * Return: 0 on success, -1 if memory ran out
+ */
+static int load_records(shell_t *hsh, program_t **progs, const char *strings)
+{
+	const snap_header_t *hdr = hsh->snapshot.map;
+	const snap_record_t *rec = (const snap_record_t *)(hdr + 1);
+	const char *name, *value, *words;
+	size_t i, n_names = hdr->n_vars + hdr->n_aliases;
+	int flags;
+
+	for (i = 0; i < n_names + hdr->n_functions; i++, rec++)
+	{
+		name = strings + rec->name;
+		if (i >= n_names)
+		{
+			if (define_function(hsh, name, progs[rec->value],
+						rec->info))
+				return (-1);
+			continue;
+		}
+		if (i >= hdr->n_vars)
+		{
+			value = strings + rec->value;
+			words = NULL;
+			if (rec->info > 0)
+				words = value + _strlen(value) + 1;
+			if (add_alias(&hsh->aliases, name, value, words,
+					rec->info - (rec->info > 0)) == NULL)
+				return (-1);
+			continue;
+		}
+		flags = rec->info & (VAR_EXPORT | VAR_READONLY);
+		value = (rec->info & VAR_UNSET) ? NULL : name + rec->value + 1;
+		if ((flags & VAR_EXPORT) &&
+			find_env(&hsh->env, name, rec->value) != NULL)
+			value = NULL;
+		if (set_var(&hsh->env, name, rec->value, value, flags) == -1)
+			return (-1);
+	}
+
+	return (0);
+}
+
+/**
+ * load_snapshot - starts the shell from a snapshot saved by the snapshot
+ * builtin
+ * @hsh: contains all the data relevant to the shell's operation
+ * @path: the snapshot file
+ *
+ * Description: The file is mapped and used where it is: the functions run
+ * their bytecode from it, without parsing or compiling anything. It stays
+ * mapped until the shell exits.
+ *
+ * Return: 0 on success, -1 if the file cannot be read, was saved by
+ * another version of the shell, is damaged or memory ran out
+ */
+int load_snapshot(shell_t *hsh, const char *path)
+{
+	snapshot_t *snap = &hsh->snapshot;
+	int fd = open(path, O_RDONLY), ret = -1;
+	program_t **progs = NULL;
+	const char *strings = NULL;
+	snap_header_t *hdr;
+	struct stat st;
+
+	if (fd == -1)
+		return (-1);
+	if (fstat(fd, &st) == 0 && st.st_size > (off_t)sizeof(snap_header_t))
+	{
+		snap->map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE,
+				 fd, 0);
+		snap->map_size = st.st_size;
+	}
+	close(fd);
+	if (snap->map == MAP_FAILED || snap->map == NULL)
+	{
+		snap->map = NULL;
+		return (-1);
+	}
+	hdr = snap->map;
+	if (!memcmp(hdr->magic, SNAP_MAGIC, 4) && hdr->version == CACHE_VERSION)
+		progs = malloc((hdr->n_progs + 1) * sizeof(program_t *));
+	if (progs != NULL)
+		strings = map_programs(hsh, progs);
+	if (strings != NULL && check_records(hdr, progs, strings))
+		ret = load_records(hsh, progs, strings);
+	safe_free(progs);
+	if (ret == 0)
+	{
+		/* PATH may have come with the snapshot */
+		free_list(&hsh->path_list);
+		build_path(&hsh->env, &hsh->path_list);
+	}
+
+	return (ret);
+}
+
+/**
+ * free_snapshot - unmaps the snapshot the shell was started from
+ * @snap: the snapshot
+ */
+void free_snapshot(snapshot_t *snap)
+{
+	if (snap->map != NULL)
+		munmap(snap->map, snap->map_size);
+	snap->map = NULL;
+}
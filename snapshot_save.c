@@ -0,0 +1,215 @@
+#include "shell.h"
+
+/**
+ * snap_string - adds a string to the strings of a snapshot
+ * @w: the snapshot, its oom flag is set on failure
+ * @text: the string, not necessarily NUL-terminated
+ * @len: its length
+ *
+ * Return: the offset of the string, NUL-terminated
+ */
+static uint32_t snap_string(snap_writer_t *w, const char *text, size_t len)
+{
+	size_t size = w->strings_size ? w->strings_size : 4096, offset;
+	char *strings;
+
+	while (w->strings_len + len + 1 > size)
+		size *= 2;
+	if (size != w->strings_size)
+	{
+		strings = _realloc(w->strings, w->strings_size, size);
+		if (strings == NULL)
+		{
+			w->oom = 1;
+			return (0);
+		}
+		w->strings = strings;
+		w->strings_size = size;
+	}
+	offset = w->strings_len;
+	_memcpy(w->strings + offset, text, len);
+	w->strings[offset + len] = '\0';
+	w->strings_len += len + 1;
+
+	return (offset);
+}
+
+/**
+ * snap_state - puts the variables, aliases and functions of the shell in a
+ * snapshot, in that order
+ * @hsh: contains all the data relevant to the shell's operation
+ * @w: the snapshot, empty, room made for the records and programs
+ */
+static void snap_state(shell_t *hsh, snap_writer_t *w)
+{
+	const env_var_t *var = hsh->env.slots, *end_var = var + hsh->env.size;
+	const alias_t *al = hsh->aliases.slots;
+	const alias_t *end_al = al + hsh->aliases.size;
+	const command_t *cmd = hsh->commands.slots;
+	const command_t *end_cmd = cmd + hsh->commands.size;
+	snap_record_t *rec = w->records;
+	size_t i;
+
+	for (; var < end_var; var++)
+	{
+		if (var->entry == NULL)
+			continue;
+		rec->name = snap_string(w, var->entry, _strlen(var->entry));
+		rec->value = var->name_len;
+		(rec++)->info = var->flags;
+	}
+	for (; al < end_al; al++)
+	{
+		if (al->name == NULL)
+			continue;
+		rec->name = snap_string(w, al->name, _strlen(al->name));
+		rec->value = snap_string(w, al->value, _strlen(al->value));
+		/* the words of the value follow it, split already */
+		for (i = 0; al->words != NULL && i < al->n_words; i++)
+			snap_string(w, al->words[i], _strlen(al->words[i]));
+		(rec++)->info = (al->words != NULL) ? al->n_words + 1 : 0;
+	}
+	for (; cmd < end_cmd; cmd++)
+	{
+		if (cmd->name == NULL || cmd->prog == NULL)
+			continue;
+		for (i = 0; i < w->n_progs && w->progs[i] != cmd->prog; i++)
+			;
+		if (i == w->n_progs)
+			w->progs[w->n_progs++] = cmd->prog;
+		rec->name = snap_string(w, cmd->name, _strlen(cmd->name));
+		rec->value = i;
+		(rec++)->info = cmd->start;
+	}
+	w->n_records = rec - w->records;
+}
+
+/**
+ * write_snapshot - writes a snapshot to a file
+ * @fd: the file
+ * @w: the snapshot
+ * @hsh: the shell it was taken from
+ *
+ * Return: 0 on success, -1 on failure
+ */
+static int write_snapshot(int fd, const snap_writer_t *w, const shell_t *hsh)
+{
+	static const char pad[8];
+	const program_t *prog;
+	snap_header_t hdr;
+	snap_prog_t sizes;
+	size_t i;
+
+	memset(&hdr, 0, sizeof(hdr));
+	memcpy(hdr.magic, SNAP_MAGIC, 4);
+	hdr.version = CACHE_VERSION;
+	hdr.n_vars = hsh->env.count;
+	hdr.n_aliases = hsh->aliases.count;
+	hdr.n_functions = w->n_records - hdr.n_vars - hdr.n_aliases;
+	hdr.n_progs = w->n_progs;
+	hdr.strings_len = w->strings_len;
+	if (write_all(fd, &hdr, sizeof(hdr)) == -1 ||
+		write_all(fd, w->records,
+			  w->n_records * sizeof(snap_record_t)) == -1)
+		return (-1);
+	for (i = 0; i < w->n_progs; i++)
+	{
+		sizes.n_code = w->progs[i]->n_code;
+		sizes.n_words = w->progs[i]->n_words;
+		sizes.strings_len = w->progs[i]->strings_len;
+		if (write_all(fd, &sizes, sizeof(sizes)) == -1)
+			return (-1);
+	}
+	for (i = 0; i < w->n_progs; i++)
+	{
+		prog = w->progs[i];
+		if (write_all(fd, prog->code,
+			      prog->n_code * sizeof(insn_t)) == -1 ||
+			write_all(fd, prog->words,
+				  prog->n_words * sizeof(uint32_t)) == -1 ||
+			write_all(fd, prog->strings, prog->strings_len) == -1 ||
+			write_all(fd, pad, -prog->strings_len & 7) == -1)
+			return (-1);
+	}
+
+	return (write_all(fd, w->strings, w->strings_len));
+}
+
+/**
+ * save_snapshot - saves the state of the shell to a file
+ * @hsh: contains all the data relevant to the shell's operation
+ * @path: the file
+ *
+ * Description: The variables with their attributes, the aliases and the
+ * functions are saved, the functions as the programs they were compiled
+ * in. The file is written aside and renamed over the old one, so shells
+ * started from it at the same time never see half of it.
+ *
+ * Return: 0 on success, -1 on failure
+ */
+int save_snapshot(shell_t *hsh, const char *path)
+{
+	size_t n = hsh->env.count + hsh->aliases.count + hsh->commands.count;
+	char *tmp = malloc(_strlen(path) + 8);
+	snap_writer_t w;
+	int fd = -1, ret = -1;
+
+	memset(&w, 0, sizeof(w));
+	w.records = malloc((n + 1) * sizeof(snap_record_t));
+	w.progs = malloc((n + 1) * sizeof(program_t *));
+	if (tmp == NULL || w.records == NULL || w.progs == NULL)
+		w.oom = 1;
+	else
+		snap_state(hsh, &w);
+	if (!w.oom)
+	{
+		sprintf(tmp, "%s.XXXXXX", path);
+		fd = mkstemp(tmp);
+	}
+	if (fd != -1)
+	{
+		ret = write_snapshot(fd, &w, hsh);
+		if (close(fd) == -1 || ret == -1 || rename(tmp, path) == -1)
+		{
+			unlink(tmp);
+			ret = -1;
+		}
+	}
+	safe_free(tmp);
+	safe_free(w.records);
+	safe_free(w.strings);
+	safe_free(w.progs);
+
+	return (ret);
+}
+
+/**
+ * builtin_snapshot - handles the builtin `snapshot` command
+ * @hsh: contains all the data relevant to the shell's operation
+ *
+ * Description: "snapshot save FILE" saves the state of the shell, a shell
+ * started with "-S FILE" picks it up as it was.
+ *
+ * Return: 0 on success, 1 if the file could not be written, else 2
+ */
+int builtin_snapshot(shell_t *hsh)
+{
+	char **args = hsh->sub_command;
+
+	if (args[1] == NULL || _strcmp(args[1], "save") || args[2] == NULL ||
+		args[3] != NULL)
+	{
+		fprintf(stderr, "%s: %lu: snapshot: usage: %s\n",
+				hsh->prog_name, hsh->cmd_count,
+				"snapshot save FILE");
+		return (CMD_ERR);
+	}
+	if (save_snapshot(hsh, args[2]) == -1)
+	{
+		fprintf(stderr, "%s: %lu: snapshot: can't save %s\n",
+				hsh->prog_name, hsh->cmd_count, args[2]);
+		return (1);
+	}
+
+	return (0);
+}
@@ -0,0 +1,163 @@
+#include "shell.h"
+
+/**
+ * expand_value - expands the parameters of an assignment and removes its
+ * quotes
+ * @hsh: shell data
+ * @word: the assignment, "NAME=value" as it was written
+ *
+ * Description: The value is neither split nor globbed, the fields "$@"
+ * gives are joined with spaces.
+ *
+ * Return: the assignment, valid until the next expansion, NULL on errors
+ */
+static const char *expand_value(shell_t *hsh, const char *word)
+{
+	expand_t *x = &hsh->expand;
+	size_t i;
+
+	if (expand_word(hsh, word, EXPAND_FIELDS) <= 0)
+		return (NULL);
+	for (i = 0; i + 1 < x->len; i++)
+	{
+		if (x->buf[i] == '\0')
+			x->buf[i] = ' ';
+	}
+
+	return (x->buf);
+}
+
+/**
+ * assign_var - sets a shell variable, or adds attributes to it
+ * @hsh: shell data
+ * @name: the name, not necessarily NUL-terminated
+ * @len: length of the name
+ * @value: the value, NULL to only add @flags
+ * @flags: attributes to add (VAR_EXPORT, VAR_READONLY)
+ *
+ * Return: 0 on success, -1 if the variable is read-only or memory ran out,
+ * which is reported
+ */
+int assign_var(shell_t *hsh, const char *name, size_t len, const char *value,
+			   int flags)
+{
+	int r = set_var(&hsh->env, name, len, value, flags);
+
+	if (r == 1)
+		fprintf(stderr, "%s: %lu: %.*s: is read only\n", hsh->prog_name,
+				hsh->cmd_count, (int)len, name);
+	else if (r == -1)
+		fprintf(stderr, "Not enough system memory to continue\n");
+
+	return (r ? -1 : 0);
+}
+
+/**
+ * overlay_var - puts an assignment in front of a command over the variables
+ * @hsh: shell data
+ * @entry: the assignment, "NAME=value", kept until the command is done
+ * @len: length of the name
+ *
+ * Return: 0 on success, -1 if the variable is read-only or memory ran out,
+ * which is reported
+ */
+static int overlay_var(shell_t *hsh, char *entry, size_t len)
+{
+	env_var_t *var = find_var(&hsh->env, entry, len);
+
+	if (var != NULL && (var->flags & VAR_READONLY))
+	{
+		fprintf(stderr, "%s: %lu: %.*s: is read only\n", hsh->prog_name,
+				hsh->cmd_count, (int)len, entry);
+		return (-1);
+	}
+	if (push_overlay(&hsh->env, entry) == -1)
+	{
+		fprintf(stderr, "Not enough system memory to continue\n");
+		return (-1);
+	}
+
+	return (0);
+}
+
+/**
+ * run_assign - runs the assignments of a command
+ * @hsh: shell data
+ * @prog: the program
+ * @in: the OP_ASSIGN or OP_OVERLAY instruction
+ *
+ * Description: A command made of assignments sets the variables one after
+ * the other, so a value can use the variables set before it, and a new one
+ * is not exported. Those in front of a command are put over the variables
+ * until it is done instead, and exported for it, the table itself is left
+ * alone, and a read-only variable cannot be given another value for it
+ * either. The command is not run if one of them fails, or if a word has
+ * no '=', which only a damaged cache file or snapshot can give.
+ *
+ * Return: the exit code of the assignments
+ */
+int run_assign(shell_t *hsh, const program_t *prog, const insn_t *in)
+{
+	const char *word, *eq;
+	uint32_t w;
+	int32_t i;
+	int r = 0;
+
+	for (i = 0; r == 0 && i < in->b; i++)
+	{
+		w = prog->words[in->a + i];
+		word = prog->strings + WORD_OFFSET(w);
+		if (w & WORD_RAW)
+			word = expand_value(hsh, word);
+		if (word != NULL && (w & WORD_RAW) && in->op == OP_OVERLAY)
+			word = arena_strdup(&hsh->arena, word);
+		eq = (word != NULL) ? _strchr(word, '=') : NULL;
+		if (word != NULL && eq == NULL)
+			fprintf(stderr, "%s: %lu: %s: bad assignment\n",
+					hsh->prog_name, hsh->cmd_count, word);
+		if (eq == NULL)
+			r = -1;
+		else if (in->op == OP_OVERLAY)
+			r = overlay_var(hsh, (char *)word, eq - word);
+		else
+			r = assign_var(hsh, word, eq - word, eq + 1, 0);
+	}
+	if (r == 0)
+		return (0);
+	if (in->op == OP_OVERLAY)
+		hsh->sub_command = NULL;
+
+	return (CMD_ERR);
+}
+
+/**
+ * builtin_unset - handles the builtin `unset` command
+ * @hsh: contains all the data relevant to the shell's operation
+ *
+ * Return: 0 on success, else 2
+ */
+int builtin_unset(shell_t *hsh)
+{
+	char **arg = hsh->sub_command + 1;
+	int status = 0;
+
+	if (*arg != NULL && !_strcmp(*arg, "-v"))
+		arg++;
+	for (; *arg != NULL; arg++)
+	{
+		if (!is_name(*arg, _strlen(*arg)))
+		{
+			fprintf(stderr, "%s: %lu: unset: %s: bad variable name\n",
+					hsh->prog_name, hsh->cmd_count, *arg);
+			status = CMD_ERR;
+		}
+		else if (_unsetenv(&hsh->env, *arg) == -1)
+		{
+			fprintf(stderr, "%s: %lu: unset: %s: is read only\n",
+					hsh->prog_name, hsh->cmd_count, *arg);
+			status = CMD_ERR;
+		}
+	}
+
+	return (status);
+}
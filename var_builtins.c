@@ -0,0 +1,134 @@
+#include "shell.h"
+
+/**
+ * cmp_vars - orders two variables by name, for qsort()
+ * @a: the first variable
+ * @b: the second variable
+ *
+ * Return: less than, equal to or greater than 0 as @a's name sorts before,
+ * with or after @b's
+ */
+static int cmp_vars(const void *a, const void *b)
+{
+	const char *x = (*(env_var_t *const *)a)->entry;
+	const char *y = (*(env_var_t *const *)b)->entry;
+
+	for (; *x == *y && *x != '='; x++, y++)
+		;
+
+	return (((*x == '=') ? 0 : (unsigned char)*x) -
+			((*y == '=') ? 0 : (unsigned char)*y));
+}
+
+/**
+ * print_vars - prints the variables that have an attribute, sorted by
+ * name, as commands setting them again
+ * @hsh: contains all the data relevant to the shell's operation
+ * @flag: the attribute (VAR_EXPORT or VAR_READONLY)
+ * @verb: the builtin giving it
+ *
+ * Return: 0 on success, 1 if memory ran out
+ */
+static int print_vars(shell_t *hsh, int flag, const char *verb)
+{
+	env_t *env = &hsh->env;
+	env_var_t **vars = malloc((env->count + 1) * sizeof(env_var_t *));
+	size_t i, n = 0;
+	const char *p;
+
+	if (vars == NULL)
+	{
+		fprintf(stderr, "Not enough system memory to continue\n");
+		return (1);
+	}
+	for (i = 0; i < env->size; i++)
+	{
+		if (env->slots[i].entry != NULL && (env->slots[i].flags & flag))
+			vars[n++] = &env->slots[i];
+	}
+	qsort(vars, n, sizeof(env_var_t *), cmp_vars);
+	for (i = 0; i < n; i++)
+	{
+		printf("%s %.*s", verb, (int)vars[i]->name_len, vars[i]->entry);
+		/* single quotes, a quote in the value ends and reopens them */
+		if (!(vars[i]->flags & VAR_UNSET))
+		{
+			putchar('=');
+			putchar('\'');
+			for (p = vars[i]->entry + vars[i]->name_len + 1; *p != '\0'; p++)
+			{
+				if (*p == '\'')
+					fputs("'\\''", stdout);
+				else
+					putchar(*p);
+			}
+			putchar('\'');
+		}
+		putchar('\n');
+	}
+	safe_free(vars);
+
+	return (0);
+}
+
+/**
+ * declare_vars - gives an attribute to the variables named by the
+ * arguments of the current command, setting those given a value
+ * @hsh: contains all the data relevant to the shell's operation
+ * @flag: the attribute (VAR_EXPORT or VAR_READONLY)
+ * @verb: the builtin giving it
+ *
+ * Description: Without arguments, or with "-p" alone, the variables that
+ * have the attribute are printed instead.
+ *
+ * Return: 0 on success, else 2
+ */
+static int declare_vars(shell_t *hsh, int flag, const char *verb)
+{
+	char **arg = hsh->sub_command + 1, *eq;
+	int status = 0;
+	size_t len;
+
+	if (*arg != NULL && !_strcmp(*arg, "-p"))
+		arg++;
+	if (*arg == NULL)
+		return (print_vars(hsh, flag, verb));
+	for (; *arg != NULL; arg++)
+	{
+		eq = _strchr(*arg, '=');
+		len = (eq != NULL) ? (size_t)(eq - *arg) : _strlen(*arg);
+		if (!is_name(*arg, len))
+		{
+			fprintf(stderr, "%s: %lu: %s: %s: bad variable name\n",
+					hsh->prog_name, hsh->cmd_count, verb, *arg);
+			status = CMD_ERR;
+		}
+		else if (assign_var(hsh, *arg, len, (eq != NULL) ? eq + 1 : NULL,
+							flag) == -1)
+			status = CMD_ERR;
+	}
+
+	return (status);
+}
+
+/**
+ * builtin_export - handles the builtin `export` command
+ * @hsh: contains all the data relevant to the shell's operation
+ *
+ * Return: 0 on success, else 2
+ */
+int builtin_export(shell_t *hsh)
+{
+	return (declare_vars(hsh, VAR_EXPORT, "export"));
+}
+
+/**
+ * builtin_readonly - handles the builtin `readonly` command
+ * @hsh: contains all the data relevant to the shell's operation
+ *
+ * Return: 0 on success, else 2
+ */
+int builtin_readonly(shell_t *hsh)
+{
+	return (declare_vars(hsh, VAR_READONLY, "readonly"));
+}
@@ -0,0 +1,258 @@
+#include "shell.h"
+
+/**
+ * run_command - executes the instructions building and running a command
+ * @hsh: contains all the data relevant to the shell's operation
+ * @prog: the program
+ * @in: the instruction
+ *
+ * Description: The arguments point at the program's words, only the array
+ * and the expanded words are allocated, from the arena. They are given back
+ * by vm_run() once the command has run. The name of a command is interned
+ * the first time it runs, builtins and functions are then found by it with
+ * a single lookup.
+ */
+static void run_command(shell_t *hsh, program_t *prog, const insn_t *in)
+{
+	char *alias_cmd, *none = NULL;
+	command_t *cmd;
+	int32_t i;
+
+	switch (in->op)
+	{
+	case OP_ARGV:
+		hsh->sub_command = arena_alloc(&hsh->arena,
+									   (in->b + 1) * sizeof(char *));
+		if (hsh->sub_command == NULL)
+		{
+			fprintf(stderr, "Memory allocation failed...\n");
+			return;
+		}
+		for (i = 0; i < in->b; i++)
+			hsh->sub_command[i] = prog->strings + prog->words[in->a + i];
+		hsh->sub_command[in->b] = NULL;
+		hsh->cmd_name = command_name(prog, in);
+		return;
+	case OP_PARAMS:
+		hsh->sub_command = copy_items(&hsh->arena, (hsh->call != NULL) ?
+									  hsh->call->args + 1 : &none);
+		hsh->cmd_name = NULL;
+		return;
+	case OP_EXPAND:
+		hsh->sub_command = expand_args(hsh, prog, in);
+		hsh->cmd_name = command_name(prog, in);
+		return;
+	case OP_ALIAS:
+		alias_cmd = arena_strdup(&hsh->arena, prog->strings + in->a);
+		if (alias_cmd != NULL)
+			parse_helper(hsh, alias_cmd);
+		break;
+	case OP_BUILTIN:
+		/* an alias or a function may be named after the builtin */
+		cmd = (hsh->sub_command != NULL) ? resolve_command(hsh) : NULL;
+		if (cmd != NULL && !cmd->alias && cmd->prog == NULL)
+			hsh->exit_code = run_builtin(hsh, in->a);
+		else if (hsh->sub_command != NULL)
+			parse_helper(hsh, NULL);
+		break;
+	default:
+		if (hsh->sub_command != NULL && hsh->sub_command[0] != NULL)
+			parse_helper(hsh, NULL);
+	}
+
+	hsh->sub_command = NULL;
+	hsh->cmd_name = NULL;
+	hsh->env.n_overlay = hsh->env.base; /* its assignments are gone */
+}
+
+/**
+ * spawn_stage - forks a child running one stage of a pipeline
+ * @hsh: contains all the data relevant to the shell's operation
+ * @prog: the program
+ * @pc: the stage's first instruction, following its OP_STAGE
+ * @fds: the standard input and output to give the stage
+ * @unused_fd: the read end of the stage's output pipe, closed in the child
+ *
+ * Return: the child's pid in the parent, -1 on failure
+ */
+static pid_t spawn_stage(shell_t *hsh, program_t *prog, size_t pc,
+						 int fds[2], int unused_fd)
+{
+	pid_t pid = fork();
+
+	if (pid != 0)
+		return (pid);
+
+	if (unused_fd != -1)
+		close(unused_fd);
+	if (fds[0] != STDIN_FILENO)
+	{
+		dup2(fds[0], STDIN_FILENO);
+		close(fds[0]);
+	}
+	if (fds[1] != STDOUT_FILENO)
+	{
+		dup2(fds[1], STDOUT_FILENO);
+		close(fds[1]);
+	}
+	/* the program of a simple command replaces the child, no need to fork */
+	hsh->subshell = prog->code[pc - 1].b;
+	vm_run(hsh, prog, pc);
+	fflush(stdout);
+	_exit(hsh->exit_code);
+}
+
+/**
+ * run_piped - runs the stages of a pipeline, each in its own child
+ * @hsh: contains all the data relevant to the shell's operation
+ * @prog: the program
+ * @pc: the first OP_STAGE of the pipeline
+ * @end: the end of the pipeline
+ *
+ * Return: the exit code of the last stage of the pipeline
+ */
+static int run_piped(shell_t *hsh, program_t *prog, size_t pc,
+					 size_t end)
+{
+	int pipe_fds[2], fds[2], status, exit_code = 0;
+	pid_t pid, last = -1;
+
+	for (fds[0] = STDIN_FILENO; pc != end; pc = prog->code[pc].a)
+	{
+		pipe_fds[0] = -1;
+		pipe_fds[1] = STDOUT_FILENO;
+		if ((size_t)prog->code[pc].a != end && pipe(pipe_fds) == -1)
+		{
+			perror("pipe");
+			break;
+		}
+		fds[1] = pipe_fds[1];
+		last = spawn_stage(hsh, prog, pc + 1, fds, pipe_fds[0]);
+		if (fds[0] != STDIN_FILENO)
+			close(fds[0]);
+		if (fds[1] != STDOUT_FILENO)
+			close(fds[1]);
+		fds[0] = pipe_fds[0];
+		if (last == -1)
+		{
+			perror("fork");
+			break;
+		}
+	}
+	if (fds[0] != STDIN_FILENO && fds[0] != -1)
+		close(fds[0]);
+
+	while ((pid = wait(&status)) != -1)
+	{
+		if (pid == last && WIFEXITED(status))
+			exit_code = WEXITSTATUS(status);
+		else if (pid == last && WIFSIGNALED(status))
+			exit_code = 128 + WTERMSIG(status);
+	}
+
+	return (exit_code);
+}
+
+/**
+ * end_run - ends a vm_run() call
+ * @hsh: contains all the data relevant to the shell's operation
+ * @depth: number of loops running when the call started
+ * @base: the arena in use when the call started
+ *
+ * Return: the exit code of the last executed command
+ */
+static int end_run(shell_t *hsh, size_t depth, arena_mark_t base)
+{
+	pop_loops(&hsh->loops, hsh->loops.count - depth);
+	arena_release(&hsh->arena, base);
+
+	return (hsh->exit_code);
+}
+
+/**
+ * vm_run - executes a compiled program
+ * @hsh: contains all the data relevant to the shell's operation
+ * @prog: the program
+ * @pc: the instruction to start at
+ *
+ * Description: Runs until OP_HALT, the end of the pipeline stage it was
+ * started in, or the return builtin. The loops started by the program are
+ * pushed on the shell's loop stack, above those of the calls it is nested
+ * in. What a command allocates from the arena is given back once it has
+ * run, down to where the innermost loop started, so that its words stay.
+ *
+ * Return: the exit code of the last executed command
+ */
+int vm_run(shell_t *hsh, program_t *prog, size_t pc)
+{
+	size_t depth = hsh->loops.count;
+	arena_mark_t base = arena_mark(&hsh->arena);
+	const insn_t *in;
+	intmax_t value;
+
+	for (;;)
+	{
+		in = &prog->code[pc++];
+		switch (in->op)
+		{
+		case OP_HALT:
+		case OP_STAGE_END:
+			return (end_run(hsh, depth, base));
+		case OP_JMP:
+			pc = in->a;
+			break;
+		case OP_JZ:
+			if (hsh->exit_code == 0)
+				pc = in->a;
+			break;
+		case OP_JNZ:
+			if (hsh->exit_code != 0)
+				pc = in->a;
+			break;
+		case OP_NOT:
+			hsh->exit_code = !hsh->exit_code;
+			break;
+		case OP_SET:
+			hsh->exit_code = in->a;
+			break;
+		case OP_ARITH: /* errors leave the exit code 2 */
+			if (arith_eval(hsh, prog->strings + in->a,
+						   _strlen(prog->strings + in->a), &value) == 0)
+				hsh->exit_code = (value == 0);
+			break;
+		case OP_ASSIGN:
+		case OP_OVERLAY:
+			hsh->exit_code = run_assign(hsh, prog, in);
+			break;
+		case OP_LOOP:
+		case OP_SAVE:
+		case OP_ENDLOOP:
+		case OP_BREAK:
+		case OP_NEXT:
+			run_loop_op(hsh, prog, in, &hsh->loops, &pc);
+			break;
+		case OP_DEFUN:
+			if (define_function(hsh, prog->strings + in->b, prog, pc) == -1)
+				hsh->exit_code = 1;
+			else
+				hsh->exit_code = 0;
+			pc = in->a;
+			break;
+		case OP_CASE:
+			pc = run_case(hsh, prog, pc);
+			arena_release(&hsh->arena, loop_floor(&hsh->loops, depth, base));
+			break;
+		case OP_PIPE:
+			hsh->exit_code = run_piped(hsh, prog, pc, in->a);
+			pc = in->a;
+			break;
+		default:
+			run_command(hsh, prog, in);
+			if (hsh->returning)
+				return (end_run(hsh, depth, base));
+			if (hsh->sub_command == NULL) /* the command is done */
+				arena_release(&hsh->arena,
+							  loop_floor(&hsh->loops, depth, base));
+		}
+	}
+}
@@ -0,0 +1,83 @@
+#include "shell.h"
+
+/**
+ * find_literal - looks a word up among the literal patterns of a case
+ * @prog: the program
+ * @slots: the hash table of the literal patterns
+ * @n_slots: number of slots, a power of two
+ * @word: the word
+ *
+ * Return: the first instruction of the arm, -1 if no literal pattern is
+ * the word
+ */
+static int32_t find_literal(const program_t *prog, const insn_t *slots,
+							int32_t n_slots, const char *word)
+{
+	size_t i = hash_name(word) & (n_slots - 1);
+	int32_t n;
+
+	for (n = 0; n < n_slots && slots[i].a != -1; n++)
+	{
+		if (!_strcmp(prog->strings + slots[i].a, word))
+			return (slots[i].b);
+		i = (i + 1) & (n_slots - 1);
+	}
+
+	return (-1);
+}
+
+/**
+ * match_arm - matches a word against a wildcard pattern of a case
+ * @hsh: contains all the data relevant to the shell's operation
+ * @prog: the program
+ * @arm: the pattern's entry
+ * @word: the word
+ *
+ * Return: 1 if the word matches, 0 otherwise
+ */
+static int match_arm(shell_t *hsh, const program_t *prog, const insn_t *arm,
+					 const char *word)
+{
+	const char *pattern = prog->strings + arm->a;
+
+	if (arm->op == OP_GLOBVAR)
+		pattern = expand_pattern(hsh, pattern);
+
+	return (pattern != NULL && glob_match(pattern, word));
+}
+
+/**
+ * run_case - chooses the arm of a case command
+ * @hsh: contains all the data relevant to the shell's operation
+ * @prog: the program
+ * @pc: the instruction following the OP_CASE, the arms' table
+ *
+ * Description: The word is looked up among the literal patterns first.
+ * The wildcard patterns are then only tried for the arms coming before the
+ * one that was found, in order.
+ *
+ * Return: the next instruction: the first of the arm, or the one following
+ * the table if no arm matched
+ */
+size_t run_case(shell_t *hsh, const program_t *prog, size_t pc)
+{
+	const insn_t *in = &prog->code[pc - 1], *globs = in + 1 + in->a;
+	const char *word = "";
+	int32_t target = -1, i;
+
+	if (hsh->sub_command != NULL && hsh->sub_command[0] != NULL)
+		word = hsh->sub_command[0];
+	if (in->a > 0)
+		target = find_literal(prog, in + 1, in->a, word);
+	for (i = 0; i < in->b && (target == -1 || globs[i].b < target); i++)
+	{
+		if (match_arm(hsh, prog, &globs[i], word))
+		{
+			target = globs[i].b;
+			break;
+		}
+	}
+	hsh->sub_command = NULL;
+
+	return ((target != -1) ? (size_t)target : pc + in->a + in->b);
+}
@@ -0,0 +1,160 @@
+#include "shell.h"
+
+/**
+ * copy_items - copies the words a for loop iterates over, or the arguments
+ * of a function
+ * @arena: the arena to copy them to
+ * @argv: the expanded words
+ *
+ * Description: The words may live in buffers that change while the loop
+ * or the function runs (the environment, '$?'), so they are copied, in a
+ * single block.
+ *
+ * Return: the copy, NULL if memory ran out
+ */
+char **copy_items(arena_t *arena, char **argv)
+{
+	size_t n, size = 0;
+	char **items, *p;
+
+	for (n = 0; argv[n] != NULL; n++)
+		size += _strlen(argv[n]) + 1;
+	items = arena_alloc(arena, (n + 1) * sizeof(char *) + size);
+	if (items == NULL)
+		return (NULL);
+
+	p = (char *)(items + n + 1);
+	for (n = 0; argv[n] != NULL; n++)
+	{
+		items[n] = _strcpy(p, argv[n]);
+		p += _strlen(p) + 1;
+	}
+	items[n] = NULL;
+
+	return (items);
+}
+
+/**
+ * push_loop - starts a loop
+ * @stack: the running loops
+ * @items: for 'for' loops, the words iterated over, NULL otherwise
+ * @seq: for 'for' loops over a sequence, its words, NULL otherwise
+ * @floor: the arena in use once the loop started
+ *
+ * Return: 0 on success, -1 if memory ran out
+ */
+static int push_loop(vm_stack_t *stack, char **items, brace_iter_t *seq,
+					 arena_mark_t floor)
+{
+	loop_frame_t *frames;
+	size_t size = stack->size ? stack->size * 2 : 8;
+
+	if (stack->count == stack->size)
+	{
+		frames = _realloc(stack->frames, stack->size * sizeof(loop_frame_t),
+						  size * sizeof(loop_frame_t));
+		if (frames == NULL)
+			return (-1);
+		stack->frames = frames;
+		stack->size = size;
+	}
+	stack->frames[stack->count].status = 0;
+	stack->frames[stack->count].items = items;
+	stack->frames[stack->count].index = 0;
+	stack->frames[stack->count].seq = seq;
+	stack->frames[stack->count].floor = floor;
+	stack->count++;
+
+	return (0);
+}
+
+/**
+ * pop_loops - ends the innermost running loops
+ * @stack: the running loops
+ * @n: number of loops to end
+ *
+ * Description: Their words are in the arena, given back with the command
+ * that follows the loops.
+ */
+void pop_loops(vm_stack_t *stack, size_t n)
+{
+	stack->count -= (n < stack->count) ? n : stack->count;
+}
+
+/**
+ * loop_floor - finds how far the arena can be given back after a command
+ * @stack: the running loops
+ * @depth: number of loops started outside the running vm_run() call
+ * @base: the arena in use when that call started
+ *
+ * Return: where the innermost loop of the call started, else @base
+ */
+arena_mark_t loop_floor(const vm_stack_t *stack, size_t depth,
+						arena_mark_t base)
+{
+	return ((stack->count > depth) ? stack->frames[stack->count - 1].floor
+								   : base);
+}
+
+/**
+ * run_loop_op - executes an instruction of a loop
+ * @hsh: contains all the data relevant to the shell's operation
+ * @prog: the program
+ * @in: the instruction
+ * @stack: the running loops
+ * @pc: the next instruction, updated by jumps
+ *
+ * Description: The exit code of a loop is that of the last run of its body,
+ * 0 if the body never ran, so the body's exit code is saved before the
+ * condition runs again.
+ */
+void run_loop_op(shell_t *hsh, const program_t *prog, const insn_t *in,
+				 vm_stack_t *stack, size_t *pc)
+{
+	loop_frame_t *top = stack->count ? &stack->frames[stack->count - 1] : NULL;
+	char **items = NULL;
+	brace_iter_t *seq = NULL;
+	const char *word;
+
+	if (in->op == OP_LOOP)
+	{
+		if (in->a == 1 && hsh->sub_command != NULL)
+			items = copy_items(&hsh->arena, hsh->sub_command);
+		else if (in->a == 2)
+			seq = new_brace_iter(&hsh->arena, prog->strings + in->b);
+		hsh->sub_command = NULL;
+		if ((in->a == 1 && items == NULL) || (in->a == 2 && seq == NULL) ||
+			push_loop(stack, items, seq, arena_mark(&hsh->arena)) == -1)
+		{
+			fprintf(stderr, "Not enough system memory to continue\n");
+			/* an empty loop, or none if that failed */
+			push_loop(stack, NULL, NULL, arena_mark(&hsh->arena));
+		}
+	}
+	else if (in->op == OP_SAVE && top != NULL)
+		top->status = hsh->exit_code;
+	else if (in->op == OP_ENDLOOP && top != NULL)
+	{
+		hsh->exit_code = top->status;
+		pop_loops(stack, 1);
+	}
+	else if (in->op == OP_BREAK)
+	{
+		pop_loops(stack, in->b);
+		hsh->exit_code = 0;
+		*pc = in->a;
+	}
+	else if (in->op == OP_NEXT)
+	{
+		word = NULL;
+		if (top != NULL && top->seq != NULL)
+			word = brace_next(top->seq);
+		else if (top != NULL && top->items != NULL && top->items[top->index])
+			word = top->items[top->index++];
+		if (word == NULL)
+			*pc = in->a;
+		else
+			assign_var(hsh, prog->strings + in->b,
+					   _strlen(prog->strings + in->b), word, 0);
+	}
+}